@@ -0,0 +1,111 @@
+#include "benchmarks.hpp"
+
+#include <lsqecc/patches/dense_slice.hpp>
+#include <lsqecc/patches/slice_binary.hpp>
+#include <lsqecc/layout/ascii_layout_spec.hpp>
+
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <tuple>
+
+namespace lsqecc::benchmarks
+{
+
+namespace {
+
+// A side x side lattice of routing space with a row of qubits every fourth row
+std::string sparse_qubit_layout_spec(size_t side)
+{
+    std::string spec;
+    for(size_t row = 0; row < side; row++)
+    {
+        for(size_t col = 0; col < side; col++)
+            spec += (row%4 == 0 && col%2 == 0) ? 'Q' : 'r';
+        spec += '\n';
+    }
+    return spec;
+}
+
+// Touches a handful of cells the way a slice with little activity would: one unitary, one measurement and a short
+// routed merge between two neighbouring qubits
+void apply_sparse_activity(DenseSlice& slice, size_t step)
+{
+    const Cell unitary_cell = slice.get_cell_by_id(static_cast<PatchId>(step % 16)).value();
+    slice.set_patch_activity(unitary_cell, PatchActivity::Unitary);
+
+    const Cell source = slice.get_cell_by_id(100).value();
+    const Cell target = slice.get_cell_by_id(101).value();
+    const Cell routing{source.row+1, source.col};
+    const Cell routing_end{target.row+1, target.col};
+    slice.place_sparse_patch(SparsePatch{{PatchType::Routing, PatchActivity::None},
+                                         LayoutHelpers::basic_square_patch(routing).cells}, false);
+    slice.place_sparse_patch(SparsePatch{{PatchType::Routing, PatchActivity::None},
+                                         LayoutHelpers::basic_square_patch(routing_end).cells}, false);
+    slice.activate_boundary_between(source, routing);
+    slice.activate_boundary_between(target, routing_end);
+}
+
+// Takes output without storing it, so that only the cost of writing is measured
+class DiscardingBuffer : public std::streambuf
+{
+protected:
+    int_type overflow(int_type c) override {return c;}
+    std::streamsize xsputn(const char*, std::streamsize n) override {return n;}
+};
+
+}
+
+void advance_slice_benchmarks()
+{
+    for(size_t side : {64, 256, 1024})
+    {
+        LayoutFromSpec layout{sparse_qubit_layout_spec(side), DistillationOptions{}};
+        tsl::ordered_set<PatchId> ids;
+        for(PatchId id = 0; id < 200; id++) ids.insert(id);
+        DenseSlice slice{layout, ids};
+
+        const size_t iterations = side < 1024 ? 2000 : 200;
+        size_t step = 0;
+        report(lstk::cat("advance_slice ", side, "x", side, " full sweep"), iterations, [&](){
+            apply_sparse_activity(slice, step++);
+            slice.clear_transient_patches_full_sweep();
+        });
+        report(lstk::cat("advance_slice ", side, "x", side, " dirty cells"), iterations, [&](){
+            apply_sparse_activity(slice, step++);
+            slice.clear_transient_patches();
+        });
+    }
+}
+
+void slice_output_benchmarks()
+{
+    for(size_t side : {64, 256, 1024})
+    {
+        LayoutFromSpec layout{sparse_qubit_layout_spec(side), DistillationOptions{}};
+        tsl::ordered_set<PatchId> ids;
+        for(PatchId id = 0; id < 200; id++) ids.insert(id);
+        DenseSlice slice{layout, ids};
+        DiscardingBuffer discarding_buffer;
+        std::ostream out{&discarding_buffer};
+
+        const size_t iterations = side < 1024 ? 2000 : 200;
+        size_t step = 0;
+        const std::tuple<const char*, bool, size_t> modes[] = {
+                {"whole", false, SliceBinaryWriter::default_keyframe_interval},
+                {"delta", true, SliceBinaryWriter::default_keyframe_interval},
+                {"delta without keyframes", true, 0}};
+        for(const auto& [mode, delta_encode, keyframe_interval]: modes)
+        {
+            SliceBinaryWriter writer{out, layout, delta_encode, keyframe_interval};
+            report(lstk::cat("write binary slice ", side, "x", side, " ", mode), iterations, [&](){
+                apply_sparse_activity(slice, step++);
+                writer.write(slice);
+                slice.clear_changed_cells();
+                slice.clear_transient_patches();
+            });
+        }
+    }
+}
+
+}
@@ -0,0 +1,31 @@
+#ifndef LSQECC_BENCHMARKS_HPP
+#define LSQECC_BENCHMARKS_HPP
+
+#include <lstk/lstk.hpp>
+
+#include <iostream>
+#include <string_view>
+
+namespace lsqecc::benchmarks
+{
+
+// Runs f iterations times and prints the mean time per iteration
+template<class F>
+void report(std::string_view name, size_t iterations, F&& f)
+{
+    auto start = lstk::now();
+    for(size_t i = 0; i < iterations; i++)
+        f();
+    const double seconds = lstk::seconds_since(start);
+    std::cout << name << ": " << seconds*1e9/static_cast<double>(iterations) << " ns/iteration ("
+              << iterations << " iterations)" << std::endl;
+}
+
+void advance_slice_benchmarks();
+void slice_output_benchmarks();
+void graph_search_benchmarks();
+void dependency_dag_benchmarks();
+
+}
+
+#endif //LSQECC_BENCHMARKS_HPP
@@ -0,0 +1,118 @@
+#include "benchmarks.hpp"
+
+#include <lsqecc/dag/domain_dags.hpp>
+#include <lsqecc/ls_instructions/ls_instructions.hpp>
+
+#include <random>
+#include <vector>
+
+namespace lsqecc::benchmarks
+{
+
+namespace {
+
+// CNOTs between random pairs of qubits, with a T gate every fourth gate
+std::vector<gates::Gate> random_circuit(size_t num_gates, QubitNum num_qubits)
+{
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<QubitNum> qubit{0, num_qubits-1};
+    std::vector<gates::Gate> circuit;
+    for(size_t i = 0; i < num_gates; i++)
+    {
+        const QubitNum control = qubit(rng);
+        QubitNum target = qubit(rng);
+        if(target == control) target = (target+1) % num_qubits;
+        if(i%4 == 0)
+            circuit.push_back(gates::T(control));
+        else
+            circuit.push_back(gates::CNOT(target, control));
+    }
+    return circuit;
+}
+
+// Two patch measurements between random patches, with a Pauli correction or a magic state request every fourth
+// instruction, roughly what the instruction streams produce for a circuit of T and CNOT gates
+std::vector<LSInstruction> random_ls_instructions(size_t num_instructions, PatchId num_patches)
+{
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<PatchId> patch{0, num_patches-1};
+    std::vector<LSInstruction> instructions;
+    for(size_t i = 0; i < num_instructions; i++)
+    {
+        const PatchId a = patch(rng);
+        PatchId b = patch(rng);
+        if(b == a) b = (b+1) % num_patches;
+        if(i%8 == 0)
+            instructions.push_back({SingleQubitOp{a, SingleQubitOp::Operator::Z}});
+        else if(i%8 == 4)
+            instructions.push_back({MagicStateRequest{a}});
+        else
+            instructions.push_back({MultiPatchMeasurement{{{a, PauliOperator::Z}, {b, i%2 ? PauliOperator::X : PauliOperator::Z}}, false}});
+    }
+    return instructions;
+}
+
+template<typename Instruction>
+void build_based_on_commutation(const std::vector<Instruction>& instructions)
+{
+    dag::DependencyDag<Instruction, dag::DenseDirectedGraph> dag;
+    for(const auto& instruction : instructions)
+        dag.push_instruction_based_on_commutation(Instruction{instruction});
+}
+
+template<typename Instruction>
+void build_based_on_local_commutation(const std::vector<Instruction>& instructions)
+{
+    dag::DependencyDag<Instruction, dag::DenseDirectedGraph> dag;
+    for(const auto& instruction : instructions)
+        dag.push_instruction_based_on_local_commutation(Instruction{instruction});
+}
+
+// Builds the dag, then pops it in waves of ready instructions like the dag pipeline does once per slice
+template<typename Graph>
+void build_and_drain(const std::vector<gates::Gate>& circuit)
+{
+    dag::DependencyDag<gates::Gate, Graph> dag;
+    for(const auto& gate : circuit)
+        dag.push_instruction_based_on_local_commutation(gates::Gate{gate});
+
+    std::vector<dag::label_t> wave;
+    while(!dag.empty())
+    {
+        wave.assign(dag.ready_instructions().begin(), dag.ready_instructions().end());
+        for(dag::label_t label : wave)
+            dag.pop_head(label);
+    }
+}
+
+}
+
+void dependency_dag_benchmarks()
+{
+    const auto circuit = random_circuit(10000, 64);
+    report("dependency_dag build and drain 10000 gates DirectedGraph", 1, [&](){
+        build_and_drain<dag::DirectedGraph>(circuit);
+    });
+    report("dependency_dag build and drain 10000 gates DenseDirectedGraph", 1, [&](){
+        build_and_drain<dag::DenseDirectedGraph>(circuit);
+    });
+
+    // Construction only, where commutation checks dominate
+    const auto small_circuit = random_circuit(1000, 64);
+    report("dependency_dag build based on commutation 1000 gates", 10, [&](){
+        build_based_on_commutation(small_circuit);
+    });
+    report("dependency_dag build based on local commutation 10000 gates", 10, [&](){
+        build_based_on_local_commutation(circuit);
+    });
+    const auto instructions = random_ls_instructions(10000, 64);
+    const std::vector<LSInstruction> few_instructions{instructions.begin(), instructions.begin()+1000};
+    report("dependency_dag build based on commutation 1000 ls instructions", 10, [&](){
+        build_based_on_commutation(few_instructions);
+    });
+    report("dependency_dag build based on local commutation 10000 ls instructions", 10, [&](){
+        build_based_on_local_commutation(instructions);
+    });
+}
+
+}
@@ -0,0 +1,89 @@
+#include "benchmarks.hpp"
+
+#include <lsqecc/patches/dense_slice.hpp>
+#include <lsqecc/layout/ascii_layout_spec.hpp>
+#include <lsqecc/layout/router.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lsqecc::benchmarks
+{
+
+namespace {
+
+// Routing space of the given size with a qubit at either end of the middle row and a wall with a single gap between
+// them, so routes have to detour
+std::string wide_lattice_spec(size_t rows, size_t cols)
+{
+    std::string spec;
+    for(size_t row = 0; row < rows; row++)
+    {
+        for(size_t col = 0; col < cols; col++)
+        {
+            if(row == rows/2 && (col == 0 || col == cols-1)) spec += 'Q';
+            else if(col == cols/2 && row != 0) spec += 'X';
+            else spec += 'r';
+        }
+        spec += '\n';
+    }
+    return spec;
+}
+
+}
+
+void graph_search_benchmarks()
+{
+    for(auto [rows, cols] : {std::pair<size_t,size_t>{32, 256}, {64, 1024}, {256, 2048}})
+    {
+        LayoutFromSpec layout{wide_lattice_spec(rows, cols), DistillationOptions{}};
+        DenseSlice slice{layout, {0, 1}};
+
+        std::vector<std::pair<std::string_view, GraphSearchProvider>> providers{
+                {"djikstra", GraphSearchProvider::Djikstra},
+                {"astar", GraphSearchProvider::AStar},
+                {"bucket", GraphSearchProvider::BucketAStar},
+                {"landmarks", GraphSearchProvider::LandmarkAStar},
+                {"bitboard", GraphSearchProvider::Bitboard}};
+#ifdef ENABLE_BOOST_GRAPH_SEARCH
+        providers.emplace_back("boost", GraphSearchProvider::Boost);
+        providers.emplace_back("boost_incremental", GraphSearchProvider::BoostIncremental);
+#endif
+
+        for(auto [name, provider] : providers)
+        {
+            CustomDPRouter router;
+            router.set_graph_search_provider(provider);
+            size_t route_length = 0;
+            report(lstk::cat("route ", rows, "x", cols, " ", name), 20, [&](){
+                route_length = router.find_routing_ancilla(slice, 0, PauliOperator::X, 1, PauliOperator::X)
+                        .value().cells.size();
+            });
+            std::cout << "    route length " << route_length << std::endl;
+        }
+    }
+
+    // Close the gap in the wall with a routing patch, which unlike the dead cells the layout can't know about
+    {
+        const size_t rows = 64, cols = 1024;
+        LayoutFromSpec layout{wide_lattice_spec(rows, cols), DistillationOptions{}};
+        DenseSlice slice{layout, {0, 1}};
+        slice.place_sparse_patch(SparsePatch{{PatchType::Routing, PatchActivity::None},
+                                             LayoutHelpers::basic_square_patch(Cell::from_ints(size_t{0}, cols/2)).cells}, false);
+
+        report(lstk::cat("blocked route ", rows, "x", cols, " first attempt"), 20, [&](){
+            CustomDPRouter router;
+            if(router.find_routing_ancilla(slice, 0, PauliOperator::X, 1, PauliOperator::X))
+                throw std::logic_error("Route should be blocked");
+        });
+        CustomDPRouter router;
+        report(lstk::cat("blocked route ", rows, "x", cols, " retry"), 1000, [&](){
+            if(router.find_routing_ancilla(slice, 0, PauliOperator::X, 1, PauliOperator::X))
+                throw std::logic_error("Route should be blocked");
+        });
+    }
+}
+
+}
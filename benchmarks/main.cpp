@@ -0,0 +1,10 @@
+#include "benchmarks.hpp"
+
+int main()
+{
+    lsqecc::benchmarks::advance_slice_benchmarks();
+    lsqecc::benchmarks::slice_output_benchmarks();
+    lsqecc::benchmarks::graph_search_benchmarks();
+    lsqecc::benchmarks::dependency_dag_benchmarks();
+    return 0;
+}
@@ -1,5 +1,12 @@
 #pragma once
 
+#include <lsqecc/pauli_rotations/pauli_operator.hpp>
+#include <lstk/lstk.hpp>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 namespace lsqecc::dag
 {
 
@@ -15,4 +22,57 @@ struct CommutationTrait
     static bool can_commute(const Instruction& a, const Instruction& b);
 };
 
+
+// Accesses to the same resource commute only if they are in the same group, and that group is not exclusive_access
+using AccessGroup = uint8_t;
+inline constexpr AccessGroup exclusive_access = 0;
+
+// Accesses that are diagonal in the eigenbasis of the same Pauli operator commute. The identity gives exclusive_access
+inline constexpr AccessGroup diagonal_in(PauliOperator op)
+{
+    return static_cast<AccessGroup>(op);
+}
+
+/**
+ * Optional refinement of the CommutationTrait for instructions that only interact through the resources (qubits,
+ * patches) they act on. This lets a dependency dag compare new instructions against the last accesses of each resource
+ * only, instead of against the whole dag.
+ */
+template <typename Instruction>
+struct LocalCommutationTrait
+{
+    // Requirement:
+    // using Resource = ...; // Hashable
+    // template<typename F> static void for_each_access(const Instruction& instruction, F&& f);
+    //   calling f(Resource, AccessGroup) for each resource the instruction acts on
+    //
+    // Consistency with the CommutationTrait:
+    // Instructions don't commute -> they access a common resource with different groups or exclusive_access
+};
+
+template <typename Instruction>
+concept HasLocalCommutation = requires { typename LocalCommutationTrait<Instruction>::Resource; };
+
+// Commutation as seen by the LocalCommutationTrait, for CommutationTraits that have nothing more precise to say.
+// Doesn't allocate unless a acts on more than a few resources
+template <HasLocalCommutation Instruction>
+bool accesses_commute(const Instruction& a, const Instruction& b)
+{
+    using Trait = LocalCommutationTrait<Instruction>;
+    lstk::SmallVector<std::pair<typename Trait::Resource, AccessGroup>, 4> accesses_of_a;
+    Trait::for_each_access(a, [&](const typename Trait::Resource& resource, AccessGroup group)
+    {
+        accesses_of_a.push_back({resource, group});
+    });
+
+    bool commute = true;
+    Trait::for_each_access(b, [&](const typename Trait::Resource& resource, AccessGroup group)
+    {
+        for(const auto& [resource_of_a, group_of_a] : accesses_of_a)
+            if(resource_of_a == resource && (group == exclusive_access || group != group_of_a))
+                commute = false;
+    });
+    return commute;
+}
+
 } // namespace lsqecc::dag
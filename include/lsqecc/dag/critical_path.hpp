@@ -0,0 +1,70 @@
+#pragma once
+
+#include <lsqecc/dag/directed_graph.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace lsqecc::dag {
+
+
+/**
+ * Priorities for list scheduling a dependency dag: the number of instructions in the longest chain of dependants of
+ * each instruction, itself included. A dependant of a non-proximate instruction has to wait for a later slice, so trying
+ * the instructions that start the longest chains first keeps them from being delayed by instructions that nothing waits
+ * for. The chains are only those within the dag, so a windowed dag sees the chains of its window.
+ */
+class CriticalPathPriorities
+{
+public:
+    using Priority = uint32_t;
+
+    /**
+     * Recomputes the priorities once a quarter of the dag is made of instructions added since the last time, so
+     * once for a dag that is read in full and every so often for a windowed one. Until then, new instructions get
+     * priority 0 and the chains they extend keep their old priorities.
+     */
+    template<typename Dag>
+    void instructions_added(const Dag& dag, size_t count)
+    {
+        pending_ += count;
+        if(pending_ == 0 || pending_*4 < dag.size())
+            return;
+        recompute(dag);
+        pending_ = 0;
+    }
+
+    Priority of(label_t label) const
+    {
+        auto it = priorities_.find(label);
+        return it == priorities_.end() ? 0 : it->second;
+    }
+
+    // Highest first, ties broken by label
+    void sort(std::vector<label_t>& labels) const
+    {
+        std::stable_sort(labels.begin(), labels.end(), [this](label_t a, label_t b){return of(a) > of(b);});
+    }
+
+private:
+    template<typename Dag>
+    void recompute(const Dag& dag)
+    {
+        priorities_.clear();
+        for(label_t label: dag.topological_order_tails_first())
+        {
+            Priority longest_dependant_chain = 0;
+            for(label_t successor: dag.successors(label))
+                longest_dependant_chain = std::max(longest_dependant_chain, priorities_.at(successor));
+            priorities_[label] = longest_dependant_chain+1;
+        }
+    }
+
+    std::unordered_map<label_t, Priority> priorities_;
+    size_t pending_ = 0;
+};
+
+
+} // namespace lsqecc::dag
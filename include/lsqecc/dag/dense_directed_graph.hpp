@@ -0,0 +1,128 @@
+#pragma once
+
+#include <lsqecc/dag/directed_graph.hpp>
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <vector>
+
+
+namespace lsqecc {
+
+namespace dag {
+
+
+/**
+ * Same interface as DirectedGraph, for graphs whose labels are handed out in increasing order like in DependencyDag.
+ *
+ * Nodes are stored in a deque indexed by label. Removed nodes are left as tombstones, which are only dropped once they
+ * reach the front, so a graph that is consumed roughly in label order stays compact. Instead of hash sets, each node
+ * keeps two small adjacency arrays with a couple of neighbours stored inline, so that a node takes tens of bytes.
+ */
+class DenseDirectedGraph
+{
+public:
+    void add_node(label_t label);
+
+    void add_edge(label_t from, label_t to);
+
+    void remove_edge(label_t from, label_t to);
+
+    void remove_node(label_t target);
+
+    bool contains(label_t label) const;
+
+    std::vector<label_t> successors(label_t label) const;
+
+    std::vector<label_t> predecessors(label_t label) const;
+
+    size_t in_degree(label_t label) const;
+
+    void expand(label_t target, const std::vector<label_t>& replacement);
+
+    std::vector<label_t> heads() const;
+
+    std::vector<label_t> tails() const;
+
+    bool empty() const {return num_nodes_ == 0;}
+
+    size_t size() const {return num_nodes_;}
+
+    std::vector<label_t> topological_order_tails_first() const;
+
+    std::ostream& to_graphviz(std::ostream& os, const Map<label_t,std::string>& nodes_contents, std::optional<std::stringstream>&& extra_content = std::nullopt) const;
+
+private:
+    // Neighbours are stored as the low 32 bits of their label. As live labels are all within 2^32 of first_label_,
+    // that is enough to recover them
+    using StoredLabel = uint32_t;
+
+    // Insertion ordered set of neighbours, which spills to the heap past inline_capacity
+    class Adjacency
+    {
+    public:
+        static constexpr uint32_t inline_capacity = 2;
+
+        Adjacency() = default;
+        Adjacency(const Adjacency& other);
+        Adjacency(Adjacency&& other) noexcept;
+        Adjacency& operator=(Adjacency other) noexcept;
+        ~Adjacency();
+
+        uint32_t size() const {return size_;}
+        const StoredLabel* begin() const {return data();}
+        const StoredLabel* end() const {return data() + size_;}
+
+        bool contains(StoredLabel label) const;
+        void insert(StoredLabel label); // Expects label not to be there already
+        void erase(StoredLabel label);
+        void clear();
+
+    private:
+        bool is_inline() const {return capacity_ == inline_capacity;}
+        StoredLabel* data() {return is_inline() ? inline_.data() : heap_;}
+        const StoredLabel* data() const {return is_inline() ? inline_.data() : heap_;}
+
+        uint32_t size_ = 0;
+        uint32_t capacity_ = inline_capacity;
+        union
+        {
+            std::array<StoredLabel, inline_capacity> inline_{};
+            StoredLabel* heap_;
+        };
+    };
+
+    struct Node
+    {
+        Adjacency successors;
+        Adjacency predecessors;
+        bool present = false;
+    };
+
+    static StoredLabel store(label_t label) {return static_cast<StoredLabel>(label);}
+    label_t load(StoredLabel stored) const
+    {
+        return first_label_ + static_cast<StoredLabel>(stored - static_cast<StoredLabel>(first_label_));
+    }
+
+    Node& node_at(label_t label, const char* what);
+    const Node& node_at(label_t label, const char* what) const;
+
+    std::vector<label_t> labels_of(const Adjacency& adjacency) const;
+
+    // Drops the tombstones at the front
+    void trim();
+
+    std::deque<Node> nodes_;
+    label_t first_label_ = 0;
+    size_t num_nodes_ = 0;
+};
+
+
+} // namespace dag
+
+} // namespace lsqecc
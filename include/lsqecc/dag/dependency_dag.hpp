@@ -1,37 +1,226 @@
 #pragma once
 
 #include <lsqecc/dag/directed_graph.hpp>
+#include <lsqecc/dag/dense_directed_graph.hpp>
+#include <lsqecc/dag/instruction_slab.hpp>
 #include <lsqecc/dag/commutation_trait.hpp>
 
+#include <algorithm>
 #include <vector>
 #include <iostream>
+#include <set>
 #include <sstream>
+#include <unordered_map>
 
 namespace lsqecc::dag {
 
 
+// Only instructions with a LocalCommutationTrait keep track of their resources
+template<typename Instruction>
+struct ResourceFrontiers {};
+
+/**
+ * For each resource, the accesses a new instruction can directly depend on: the current group of mutually commuting
+ * accesses and the group before it. Each access in a group depends on every access of the group before, so all older
+ * accesses are ancestors of the previous group.
+ */
+template<HasLocalCommutation Instruction>
+struct ResourceFrontiers<Instruction>
+{
+    using Trait = LocalCommutationTrait<Instruction>;
+
+    struct Frontier
+    {
+        std::vector<label_t> previous;
+        std::vector<label_t> current;
+        AccessGroup current_group = exclusive_access;
+    };
+
+    // Calls add_dependency(label) for every access the instruction has to come after, possibly more than once
+    template<typename F>
+    void add_accesses(label_t label, const Instruction& instruction, F&& add_dependency)
+    {
+        Trait::for_each_access(instruction, [&](const typename Trait::Resource& resource, AccessGroup group)
+        {
+            Frontier& frontier = frontiers_[resource];
+            if(frontier.current.empty() || group == exclusive_access || group != frontier.current_group)
+            {
+                std::swap(frontier.previous, frontier.current);
+                frontier.current.clear();
+                frontier.current_group = group;
+            }
+            frontier.current.push_back(label);
+            for(label_t dependency: frontier.previous)
+                if(dependency != label)
+                    add_dependency(dependency);
+        });
+    }
+
+    void replace(label_t label, const Instruction& instruction, label_t replacement)
+    {
+        Trait::for_each_access(instruction, [&](const typename Trait::Resource& resource, AccessGroup)
+        {
+            auto it = frontiers_.find(resource);
+            if(it == frontiers_.end()) return;
+            std::replace(it->second.previous.begin(), it->second.previous.end(), label, replacement);
+            std::replace(it->second.current.begin(), it->second.current.end(), label, replacement);
+        });
+    }
+
+    // Forgets an instruction that was applied, so that resources that are no longer used take no space
+    void remove(label_t label, const Instruction& instruction)
+    {
+        Trait::for_each_access(instruction, [&](const typename Trait::Resource& resource, AccessGroup)
+        {
+            auto it = frontiers_.find(resource);
+            if(it == frontiers_.end()) return;
+            std::erase(it->second.previous, label);
+            std::erase(it->second.current, label);
+            if(it->second.previous.empty() && it->second.current.empty())
+                frontiers_.erase(it);
+        });
+    }
+
+private:
+    std::unordered_map<typename Trait::Resource, Frontier> frontiers_;
+};
+
+
+/**
+ * Pairs of instructions that must be applied on subsequent slices, indexed by both ends so that expanding or popping
+ * an instruction only touches its own proximate dependencies
+ */
+class ProximateDependencies
+{
+public:
+    void insert(label_t from, label_t to)
+    {
+        std::vector<label_t>& successors = successors_[from];
+        if(std::find(successors.begin(), successors.end(), to) != successors.end())
+            return;
+        successors.push_back(to);
+        predecessors_[to].push_back(from);
+    }
+
+    const std::vector<label_t>& predecessors(label_t label) const {return neighbours(predecessors_, label);}
+
+    const std::vector<label_t>& successors(label_t label) const {return neighbours(successors_, label);}
+
+    // Dependencies on target now point to first and dependencies from target now start at last
+    void replace(label_t target, label_t first, label_t last)
+    {
+        for(label_t to: take(successors_, target))
+        {
+            std::replace(predecessors_[to].begin(), predecessors_[to].end(), target, last);
+            successors_[last].push_back(to);
+        }
+        for(label_t from: take(predecessors_, target))
+        {
+            std::replace(successors_[from].begin(), successors_[from].end(), target, first);
+            predecessors_[first].push_back(from);
+        }
+    }
+
+    void remove(label_t label)
+    {
+        for(label_t to: take(successors_, label))
+            erase_neighbour(predecessors_, to, label);
+        for(label_t from: take(predecessors_, label))
+            erase_neighbour(successors_, from, label);
+    }
+
+    // Sorted, so that the output doesn't depend on the order of the hash maps
+    std::vector<std::pair<label_t, label_t>> pairs() const
+    {
+        std::vector<std::pair<label_t, label_t>> pairs;
+        for(const auto& [from, successors]: successors_)
+            for(label_t to: successors)
+                pairs.emplace_back(from, to);
+        std::sort(pairs.begin(), pairs.end());
+        return pairs;
+    }
+
+private:
+    using Index = std::unordered_map<label_t, std::vector<label_t>>;
+
+    static const std::vector<label_t>& neighbours(const Index& index, label_t label)
+    {
+        static const std::vector<label_t> none;
+        auto it = index.find(label);
+        return it == index.end() ? none : it->second;
+    }
+
+    static std::vector<label_t> take(Index& index, label_t label)
+    {
+        auto it = index.find(label);
+        if(it == index.end()) return {};
+        std::vector<label_t> taken = std::move(it->second);
+        index.erase(it);
+        return taken;
+    }
+
+    static void erase_neighbour(Index& index, label_t label, label_t neighbour)
+    {
+        auto it = index.find(label);
+        if(it == index.end()) return;
+        std::erase(it->second, neighbour);
+        if(it->second.empty())
+            index.erase(it);
+    }
+
+    Index successors_;
+    Index predecessors_;
+};
+
+
 /**
  * A Dag representing dependancies between instructions, where instruction can be LLI gates or any other
  * Kind of instruction that can be modelled as having dependancies.
  * 
  * Instructions must impmlement the CommutationTrait to take advantage of commutation and not be dependent
+ *
+ * Graph can be DirectedGraph or DenseDirectedGraph, which is much smaller for large dags
  */
-
-template<typename Instruction>
+template<typename Instruction, typename Graph = DirectedGraph>
 struct DependencyDag 
 {
-    using Self = DependencyDag<Instruction>;
+    using Self = DependencyDag<Instruction, Graph>;
 
     label_t push_instruction_based_on_commutation(Instruction&& instruction)
     {
         label_t new_instruction_label = add_instruction_isolated(std::move(instruction));
+        const Instruction& new_instruction = instructions_.at(new_instruction_label);
 
-        for(label_t existing_instruction_label: graph_.topological_order_tails_first())
+        // Every existing instruction is compared, so any order will do. Label order avoids sorting the graph
+        instructions_.for_each([&](label_t existing_instruction_label, const Instruction& existing_instruction)
         {
-            if(existing_instruction_label != new_instruction_label 
-               && !CommutationTrait<Instruction>::can_commute(instructions_.at(existing_instruction_label), instructions_.at(new_instruction_label)))
+            if(existing_instruction_label != new_instruction_label
+               && !CommutationTrait<Instruction>::can_commute(existing_instruction, new_instruction))
                 graph_.add_edge(existing_instruction_label, new_instruction_label);
-        }
+        });
+        if(graph_.in_degree(new_instruction_label) > 0)
+            ready_.erase(new_instruction_label);
+        return new_instruction_label;
+    }
+
+    /**
+     * Same ordering as push_instruction_based_on_commutation, but the new instruction only gets edges from the last
+     * conflicting accesses of the resources it acts on. Dependencies on older instructions follow transitively, so
+     * insertion costs O(accesses) instead of a commutation check against the whole dag.
+     */
+    label_t push_instruction_based_on_local_commutation(Instruction&& instruction)
+        requires HasLocalCommutation<Instruction>
+    {
+        label_t new_instruction_label = add_instruction_isolated(std::move(instruction));
+        resource_frontiers_.add_accesses(new_instruction_label, instructions_.at(new_instruction_label),
+            [&](label_t dependency)
+            {
+                // Instructions that were already popped don't constrain the new one
+                if(instructions_.contains(dependency))
+                    graph_.add_edge(dependency, new_instruction_label);
+            });
+        if(graph_.in_degree(new_instruction_label) > 0)
+            ready_.erase(new_instruction_label);
         return new_instruction_label;
     }
 
@@ -39,7 +228,8 @@ struct DependencyDag
     {
         label_t new_instruction_label = current_label_++;
         graph_.add_node(new_instruction_label);
-        instructions_[new_instruction_label] = std::move(instruction);
+        instructions_.insert(new_instruction_label, std::move(instruction));
+        ready_.insert(new_instruction_label);
         return new_instruction_label;
     }
 
@@ -48,13 +238,21 @@ struct DependencyDag
         return graph_.empty();
     }
 
-    std::vector<label_t> applicable_instructions() const
+    size_t size() const
     {
-        std::vector<label_t> instructions;
-        for (auto& label: graph_.heads())
-            instructions.push_back(label);
+        return instructions_.size();
+    }
+
+    // Instructions without dependencies, i.e. the heads of the graph, in label order
+    using ReadySet = std::set<label_t>;
+    const ReadySet& ready_instructions() const
+    {
+        return ready_;
+    }
 
-        return instructions;
+    std::vector<label_t> applicable_instructions() const
+    {
+        return {ready_.begin(), ready_.end()};
     }
 
     std::vector<label_t> proximate_instructions()
@@ -65,6 +263,16 @@ struct DependencyDag
         return proximate_instructions;
     }
 
+    std::vector<label_t> successors(label_t label) const
+    {
+        return graph_.successors(label);
+    }
+
+    std::vector<label_t> topological_order_tails_first() const
+    {
+        return graph_.topological_order_tails_first();
+    }
+
     Instruction& at(label_t label)
     {
         return instructions_.at(label);
@@ -73,23 +281,25 @@ struct DependencyDag
 
     const Instruction& at(label_t label) const
     {
-        return const_cast<Self*>(this)->instructions_.at(label);
+        return instructions_.at(label);
     }
 
     void pop_head(label_t label)
     {
         Instruction instruction = std::move(instructions_.at(label));
         instructions_.erase(label);
-
-        for(label_t predecessor: graph_.predecessors(label))
-        {
-            if(proximate_dependencies_.contains({predecessor, label}))
-            {
-                proximate_heads_.insert(predecessor);
-                proximate_dependencies_.erase({predecessor, label});
-            }
-        }
+        if constexpr (HasLocalCommutation<Instruction>)
+            resource_frontiers_.remove(label, instruction);
+        ready_.erase(label);
+
+        for(label_t predecessor: proximate_dependencies_.predecessors(label))
+            proximate_heads_.insert(predecessor);
+        proximate_dependencies_.remove(label);
+        const std::vector<label_t> successors = graph_.successors(label);
         graph_.remove_node(label);
+        for(label_t successor: successors)
+            if(graph_.in_degree(successor) == 0)
+                ready_.insert(successor);
 
         if(proximate_heads_.contains(label))
             proximate_heads_.erase(label);
@@ -108,29 +318,21 @@ struct DependencyDag
         {
             label_t new_label = current_label_++;
             new_lables.push_back(new_label);
-            instructions_[new_label] = std::move(instruction);
+            instructions_.insert(new_label, std::move(instruction));
         }
 
         graph_.expand(target, new_lables);
+        if(ready_.erase(target))
+            ready_.insert(new_lables.front());
+        if constexpr (HasLocalCommutation<Instruction>)
+            resource_frontiers_.replace(target, instructions_.at(target), new_lables.back());
+        instructions_.erase(target);
         if(proximate)
             for (size_t i = 0; i < replacement.size()-1; i++)
-                proximate_dependencies_.insert({new_lables[i], new_lables[i+1]});
-        
+                proximate_dependencies_.insert(new_lables[i], new_lables[i+1]);
 
         // Now do the proximity bookkeeping for the extremes of the replacement
-        for (auto&[from, to]: proximate_dependencies_)
-        {
-            if (from == target)
-            {
-                proximate_dependencies_.erase({from, to});
-                proximate_dependencies_.insert({new_lables.back(), to});
-            }
-            if (to == target)
-            {
-                proximate_dependencies_.erase({from, to});
-                proximate_dependencies_.insert({from, new_lables.front()});
-            }
-        }
+        proximate_dependencies_.replace(target, new_lables.front(), new_lables.back());
 
         if (proximate_heads_.contains(target))
         {
@@ -151,12 +353,12 @@ struct DependencyDag
         using namespace lsqecc;
 
         Map<label_t, std::string> nodes_contents;
-        for (const auto& [label, instruction]: instructions_)
+        instructions_.for_each([&](label_t label, const Instruction& instruction)
         {
             std::stringstream ss;
             ss << instruction;
             nodes_contents[label] = ss.str();
-        }
+        });
 
         std::stringstream ss;
 
@@ -164,11 +366,8 @@ struct DependencyDag
             for (auto label: proximate_heads_)
                 ss << "  " << label << " [fontcolor=red];\n";
 
-        if(proximate_dependencies_.size() > 0)
-        {
-            for (const auto& [from, to]: proximate_dependencies_)
-                ss << "  " << from << " -> " << to << " [penwidth=5];\n";
-        }
+        for (const auto& [from, to]: proximate_dependencies_.pairs())
+            ss << "  " << from << " -> " << to << " [penwidth=5];\n";
 
 
         return graph_.to_graphviz(os, nodes_contents, std::move(std::make_optional(std::move(ss))));
@@ -177,26 +376,33 @@ struct DependencyDag
 private:
     
     // The directed graph representing the instructions and their dependencies. The graph_ only tracks the dependencies
-    // while the actual instructions are stored in the instructions_ map
-    DirectedGraph graph_;
-    Map<label_t, Instruction> instructions_;
+    // while the actual instructions are stored in instructions_
+    Graph graph_;
+    InstructionSlab<Instruction> instructions_;
+
+    // Kept up to date as dependencies are added and removed, so that finding what can be applied doesn't need to scan
+    // the graph
+    ReadySet ready_;
     
-    // A set of pairs of instructions that have a proximate dependency relationship, these are instructions that must be
+    // Pairs of instructions that have a proximate dependency relationship, these are instructions that must be
     // executed on subsequent slices
-    SetOfPairs<label_t, label_t> proximate_dependencies_;
+    ProximateDependencies proximate_dependencies_;
     
     // When an instruction that had proximate dependencies is removed, the dependant instructions are added to this set
     // to track the fact that they must be added to the next slices
     Set<label_t> proximate_heads_;
     
+    // Last accesses of each resource, for push_instruction_based_on_local_commutation
+    ResourceFrontiers<Instruction> resource_frontiers_;
+
     label_t current_label_ = 0;
 
-    template<typename T>
-    friend const DirectedGraph& get_graph_for_testing(const DependencyDag<T>& g);
+    template<typename T, typename G>
+    friend const G& get_graph_for_testing(const DependencyDag<T, G>& g);
 };
 
-template<typename Instruction>
-std::string to_graphviz(const DependencyDag<Instruction>& dag)
+template<typename Instruction, typename Graph>
+std::string to_graphviz(const DependencyDag<Instruction, Graph>& dag)
 {
     std::stringstream ss;
     dag.to_graphviz(ss);
@@ -204,8 +410,8 @@ std::string to_graphviz(const DependencyDag<Instruction>& dag)
 }
 
 
-template<typename Instruction>
-static const DirectedGraph& get_graph_for_testing(const DependencyDag<Instruction>& g)
+template<typename Instruction, typename Graph>
+static const Graph& get_graph_for_testing(const DependencyDag<Instruction, Graph>& g)
 {
     return g.graph_;
 }
@@ -38,6 +38,8 @@ struct DirectedGraph
 
     std::vector<label_t> predecessors(label_t label) const;
 
+    size_t in_degree(label_t label) const;
+
     void expand(label_t target, const std::vector<label_t>& replacement);
 
     Set<label_t> heads() const;
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <lsqecc/dag/directed_graph.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace lsqecc::dag {
+
+
+/**
+ * Storage for the instructions of a DependencyDag, indexed by label.
+ *
+ * Instructions live in fixed size chunks that are never moved, so references to them stay valid while other
+ * instructions are added and removed. Slots freed by erase are reused by the next insertions, so a dag that is filled
+ * and drained over a long run keeps the same few chunks instead of allocating a node per instruction. Like
+ * DenseDirectedGraph, the label index expects labels handed out in increasing order and drops its front as the oldest
+ * labels are erased.
+ */
+template<typename T>
+class InstructionSlab
+{
+public:
+    void insert(label_t label, T&& value)
+    {
+        uint32_t& slot_index = index_entry(label);
+        if(slot_index != no_slot)
+            throw std::logic_error("Instruction already stored with label: " + std::to_string(label));
+
+        slot_index = allocate_slot();
+        slot(slot_index).value.emplace(std::move(value));
+        size_++;
+    }
+
+    bool contains(label_t label) const
+    {
+        return find(label) != no_slot;
+    }
+
+    T& at(label_t label)
+    {
+        const uint32_t slot_index = find(label);
+        if(slot_index == no_slot)
+            throw std::out_of_range("No instruction with label: " + std::to_string(label));
+        return *slot(slot_index).value;
+    }
+
+    const T& at(label_t label) const
+    {
+        return const_cast<InstructionSlab*>(this)->at(label);
+    }
+
+    void erase(label_t label)
+    {
+        const uint32_t slot_index = find(label);
+        if(slot_index == no_slot) return;
+
+        Slot& freed = slot(slot_index);
+        freed.value.reset();
+        freed.next_free = free_head_;
+        free_head_ = slot_index;
+        index_[label - first_label_] = no_slot;
+        size_--;
+
+        while(!index_.empty() && index_.front() == no_slot)
+        {
+            index_.pop_front();
+            first_label_++;
+        }
+    }
+
+    size_t size() const {return size_;}
+
+    bool empty() const {return size_ == 0;}
+
+    // Slots allocated so far, used or free
+    size_t capacity() const {return chunks_.size() * chunk_size;}
+
+    // Calls f(label, instruction) in label order
+    template<typename F>
+    void for_each(F&& f) const
+    {
+        for(size_t i = 0; i < index_.size(); i++)
+            if(index_[i] != no_slot)
+                f(first_label_ + i, *slot(index_[i]).value);
+    }
+
+private:
+    static constexpr uint32_t no_slot = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t chunk_size = 256;
+
+    struct Slot
+    {
+        std::optional<T> value;
+        uint32_t next_free = no_slot;
+    };
+
+    Slot& slot(uint32_t slot_index) {return chunks_[slot_index / chunk_size][slot_index % chunk_size];}
+    const Slot& slot(uint32_t slot_index) const {return chunks_[slot_index / chunk_size][slot_index % chunk_size];}
+
+    uint32_t allocate_slot()
+    {
+        if(free_head_ != no_slot)
+        {
+            const uint32_t reused = free_head_;
+            free_head_ = slot(reused).next_free;
+            return reused;
+        }
+        if(num_slots_ == capacity())
+        {
+            if(capacity() + chunk_size >= no_slot)
+                throw std::length_error("Too many instructions for an InstructionSlab");
+            chunks_.push_back(std::make_unique<Slot[]>(chunk_size));
+        }
+        return num_slots_++;
+    }
+
+    uint32_t find(label_t label) const
+    {
+        if(label < first_label_ || label - first_label_ >= index_.size())
+            return no_slot;
+        return index_[label - first_label_];
+    }
+
+    uint32_t& index_entry(label_t label)
+    {
+        if(index_.empty())
+            first_label_ = label;
+        else if(label < first_label_)
+        {
+            // Only happens for labels out of order, which just make the index longer
+            index_.insert(index_.begin(), first_label_ - label, no_slot);
+            first_label_ = label;
+        }
+        if(label - first_label_ >= index_.size())
+            index_.resize(label - first_label_ + 1, no_slot);
+        return index_[label - first_label_];
+    }
+
+    std::vector<std::unique_ptr<Slot[]>> chunks_;
+    uint32_t num_slots_ = 0;
+    uint32_t free_head_ = no_slot;
+
+    // Slot of each label from first_label_ on
+    std::deque<uint32_t> index_;
+    label_t first_label_ = 0;
+    size_t size_ = 0;
+};
+
+
+} // namespace lsqecc::dag
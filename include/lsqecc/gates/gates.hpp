@@ -124,6 +124,10 @@ using Gate = std::variant<BasicSingleQubitGate, RZ, ControlledGate>;
 std::vector<Gate> decompose(const Gate& gate, double rz_precision_log_ten_negative);
 bool is_decomposed(const Gate& gate);
 
+using OperatingQubits = lstk::SmallVector<QubitNum, 2>;
+
+// Same qubits in the same order as get_operating_qubits, without allocating
+OperatingQubits operating_qubits(const Gate& gate);
 tsl::ordered_set<QubitNum> get_operating_qubits(const Gate& gate);
 
 
@@ -136,21 +140,58 @@ std::ostream& operator<<(std::ostream& os, const gates::Gate& gate);
 
 
 namespace dag{
+template<>
+struct LocalCommutationTrait<gates::Gate>
+{
+    using Resource = QubitNum;
+
+    // Gates commute if, on every qubit they share, both are diagonal in the eigenbasis of the same Pauli operator.
+    // Controls are diagonal in the Z basis, so diagonal gates commute with them and CNOTs commute when they share
+    // either their control or their target
+    template<typename F>
+    static void for_each_access(const gates::Gate& gate, F&& f)
+    {
+        auto target_access = [&](const auto& target_gate){f(target_gate.target_qubit, diagonal_in(basis_of(target_gate)));};
+        if (const auto* ctrlg = std::get_if<gates::ControlledGate>(&gate))
+        {
+            f(ctrlg->control_qubit, diagonal_in(PauliOperator::Z));
+            std::visit(target_access, ctrlg->target_gate);
+        }
+        else if (const auto* basic = std::get_if<gates::BasicSingleQubitGate>(&gate))
+            target_access(*basic);
+        else
+            target_access(std::get<gates::RZ>(gate));
+    }
+
+    // PauliOperator::I for gates that aren't diagonal in any Pauli basis
+    static PauliOperator basis_of(const gates::BasicSingleQubitGate& gate)
+    {
+        using Type = gates::BasicSingleQubitGate::Type;
+        switch(gate.gate_type)
+        {
+            case Type::X: return PauliOperator::X;
+            case Type::Z:
+            case Type::S:
+            case Type::T:
+            case Type::SDg:
+            case Type::TDg: return PauliOperator::Z;
+            case Type::H: return PauliOperator::I;
+        }
+        LSTK_UNREACHABLE;
+    }
+
+    static PauliOperator basis_of(const gates::RZ&)
+    {
+        return PauliOperator::Z;
+    }
+};
+
 template<>
 struct CommutationTrait<gates::Gate>
 {
     static bool can_commute(const gates::Gate& a, const gates::Gate& b)
     {
-        // Handle the case of controlled gates separately because the if they only overlap in the index they commute
-        if (const auto* ctrlg_a = std::get_if<gates::ControlledGate>(&a))
-            if (const auto* ctrlg_b = std::get_if<gates::ControlledGate>(&b))
-                if (ctrlg_a->control_qubit == ctrlg_b->control_qubit)
-                    return lstk::set_intersection(
-                        std::visit(gates::get_operating_qubits, ctrlg_a->target_gate), 
-                        std::visit(gates::get_operating_qubits, ctrlg_b->target_gate)
-                    ).empty();
-
-        return lstk::set_intersection(gates::get_operating_qubits(a), gates::get_operating_qubits(b)).empty();
+        return accesses_commute(a, b);
     }
 };
 
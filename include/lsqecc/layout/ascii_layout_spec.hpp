@@ -128,6 +128,7 @@ public:
         return cached_distilled_state_locations_[distillation_region_idx];
     }
     const bool magic_states_reserved() const override {return magic_states_reserved_;}
+    const StaticDistances* static_distances() const override {return &*cached_static_distances_;}
 
 private:
     std::vector<SparsePatch> cached_core_patches_;
@@ -139,6 +140,7 @@ private:
     std::vector<std::vector<Cell>> cached_distilled_state_locations_;
     std::vector<Cell> cached_dead_cells_;
     bool magic_states_reserved_; 
+    std::optional<StaticDistances> cached_static_distances_;
     void init_cache(const AsciiLayoutSpec& spec, const DistillationOptions& distillation_options);
 
 };
@@ -0,0 +1,46 @@
+#ifndef LSQECC_BITBOARD_GRAPH_SEARCH_HPP
+#define LSQECC_BITBOARD_GRAPH_SEARCH_HPP
+
+#include <lsqecc/patches/slice.hpp>
+#include <lsqecc/patches/cell_bitboard.hpp>
+#include <lsqecc/layout/graph_search/custom_graph_search.hpp>
+
+namespace lsqecc {
+
+namespace bitboard_graph_search {
+
+
+// Bitboards reused across searches, plus the per cell layer numbers needed to walk the path back
+struct BitboardSearchWorkspace
+{
+    CellBitboard free_cells; // Only filled in when the slice doesn't keep its own
+    CellBitboard frontier;
+    CellBitboard next_frontier;
+    CellBitboard visited;
+    // Indices of the non zero words of frontier and next_frontier, which are otherwise kept all zeros
+    std::vector<size_t> frontier_words;
+    std::vector<size_t> next_frontier_words;
+    custom_graph_search::SearchWorkspace layers;
+};
+
+
+/*
+ * Breadth first search over the free cells, expanding the frontier a word (64 cells) at a time with shifts and masks,
+ * visiting only the words next to the current frontier. The path is then recovered by walking back through decreasing
+ * BFS layers. Source and target boundaries are checked the same way as in the custom graph search, so routes have the
+ * same length as Djikstra's.
+ */
+std::optional<RoutingRegion> graph_search_route_ancilla(
+        const Slice& slice,
+        PatchId source,
+        PauliOperator source_op,
+        PatchId target,
+        PauliOperator target_op,
+        BitboardSearchWorkspace& workspace
+);
+
+}
+
+}
+
+#endif //LSQECC_BITBOARD_GRAPH_SEARCH_HPP
@@ -4,6 +4,8 @@
 
 #include <lsqecc/patches/slice.hpp>
 
+#include <memory>
+
 namespace lsqecc {
 
 namespace boost_graph_search {
@@ -16,6 +18,43 @@ std::optional<RoutingRegion> graph_search_route_ancilla(
         PauliOperator target_op
 );
 
+
+/*
+ * A Boost graph of the free cells of a layout that is kept between searches. Each search first brings it up to date by
+ * adding or removing the edges of the cells that were freed or occupied since the previous one (found by diffing free
+ * cell bitboards), then adds the source and target edges for the duration of the search only. The predecessor and
+ * distance maps are reused too. The graph is rebuilt if the slice belongs to a different layout.
+ */
+class IncrementalGraph
+{
+public:
+    IncrementalGraph();
+    ~IncrementalGraph();
+
+    size_t num_edges() const;
+
+private:
+    friend std::optional<RoutingRegion> graph_search_route_ancilla(
+            const Slice& slice,
+            PatchId source,
+            PauliOperator source_op,
+            PatchId target,
+            PauliOperator target_op,
+            IncrementalGraph& graph);
+
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+std::optional<RoutingRegion> graph_search_route_ancilla(
+        const Slice& slice,
+        PatchId source,
+        PauliOperator source_op,
+        PatchId target,
+        PauliOperator target_op,
+        IncrementalGraph& graph
+);
+
 }
 
 }
@@ -2,6 +2,10 @@
 #define LSQECC_CUSTOM_GRAPH_SEARCH_HPP
 
 #include <lsqecc/patches/slice.hpp>
+
+#include <cstdint>
+#include <vector>
+
 namespace lsqecc {
 
 namespace custom_graph_search {
@@ -11,6 +15,65 @@ enum class Heuristic
 {
         None, // I.e. Djikstra
         Euclidean,
+        Manhattan, // Integer costs, searched with a bucket queue instead of a binary heap
+        Landmarks, // Layout::static_distances lower bounds, falls back to Manhattan for layouts without them
+};
+
+
+// Index in the data structure storing the list of vertices
+using Vertex = size_t;
+
+
+/**
+ * Scratch memory for the searches, owned by the router and reused across calls so that routing does not allocate
+ * once the arrays have grown to the size of the lattice. Entries are only valid if they were written during the
+ * current search, which is tracked with a generation stamp per vertex instead of clearing the arrays every time.
+ */
+class SearchWorkspace
+{
+public:
+    // Starts a new search over num_vertices vertices, invalidating all entries from the previous one
+    void reset(size_t num_vertices);
+
+    bool has_distance(Vertex v) const {return stamps_[v] == generation_;}
+    size_t distance(Vertex v) const {return distances_[v];}
+    // A vertex that was not reached is its own predecessor
+    Vertex predecessor(Vertex v) const {return has_distance(v) ? predecessors_[v] : v;}
+    void set(Vertex v, size_t distance, Vertex predecessor)
+    {
+        stamps_[v] = generation_;
+        distances_[v] = distance;
+        predecessors_[v] = predecessor;
+    }
+
+    // Min-heap of (priority, vertex). Stale entries are left in and skipped when popped
+    struct FrontierEntry {
+        double priority;
+        Vertex vertex;
+        bool operator>(const FrontierEntry& other) const
+        {
+            return priority > other.priority || (priority == other.priority && vertex > other.vertex);
+        }
+    };
+    bool frontier_empty() const {return frontier_.empty();}
+    void push_frontier(double priority, Vertex v);
+    FrontierEntry pop_frontier();
+
+    // Bucket (Dial) queue for searches with integer priorities. Pops the lowest priority, newest entry first
+    bool buckets_empty() const {return bucket_entries_ == 0;}
+    void push_bucket(size_t priority, Vertex v);
+    FrontierEntry pop_bucket();
+
+private:
+    uint32_t generation_ = 0;
+    std::vector<uint32_t> stamps_;
+    std::vector<size_t> distances_;
+    std::vector<Vertex> predecessors_;
+    std::vector<FrontierEntry> frontier_;
+
+    std::vector<std::vector<Vertex>> buckets_;
+    size_t lowest_bucket_ = 0;
+    size_t bucket_entries_ = 0;
 };
 
 
@@ -20,7 +83,8 @@ std::optional<RoutingRegion> graph_search_route_ancilla(
         PauliOperator source_op,
         PatchId target,
         PauliOperator target_op,
-        Heuristic heuristic
+        Heuristic heuristic,
+        SearchWorkspace& workspace
 );
 
 }
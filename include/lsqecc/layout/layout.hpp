@@ -3,6 +3,7 @@
 
 
 #include <lsqecc/patches/patches.hpp>
+#include <lsqecc/layout/static_distances.hpp>
 #include <lstk/lstk.hpp>
 
 #include <tuple>
@@ -23,6 +24,8 @@ struct Layout {
     virtual const std::vector<Cell>& dead_location() const = 0;
     virtual const std::vector<Cell>& predistilled_y_states() const = 0;
     virtual const bool magic_states_reserved() const = 0;
+    // Distances over the empty lattice, for layouts that precompute them
+    virtual const StaticDistances* static_distances() const {return nullptr;}
 
     template<class F> void for_each_cell(F f) const;
 
@@ -38,6 +41,8 @@ struct DistillationOptions{
 namespace LayoutHelpers{
     SparsePatch basic_square_patch(Cell placement, std::optional<PatchId> id = std::nullopt);
     SingleCellOccupiedByPatch make_distillation_region_cell(Cell placement);
+    // A routing cell on a path, joined to the cells before and after it
+    SingleCellOccupiedByPatch routing_cell_on_path(Cell previous, Cell placement, Cell next);
 
 
     struct SinglePatchRotationALaLitinskiStages
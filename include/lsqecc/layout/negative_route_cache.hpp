@@ -0,0 +1,84 @@
+#ifndef LSQECC_NEGATIVE_ROUTE_CACHE_HPP
+#define LSQECC_NEGATIVE_ROUTE_CACHE_HPP
+
+#include <lsqecc/patches/slice.hpp>
+#include <lsqecc/pauli_rotations/pauli_operator.hpp>
+
+#include <optional>
+#include <ostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace lsqecc {
+
+
+// What a route depends on apart from the lattice: where it starts and ends and through which boundaries
+struct RouteQuery {
+    Cell source_cell;
+    PauliOperator source_op;
+    Cell target_cell;
+    PauliOperator target_op;
+
+    static RouteQuery from_ids(const Slice& slice, PatchId source, PauliOperator source_op,
+                               PatchId target, PauliOperator target_op);
+
+    bool operator==(const RouteQuery&) const = default;
+    struct hash
+    {
+        size_t operator()( const RouteQuery& x ) const;
+    };
+};
+
+
+/*
+ * Remembers queries that could not be routed, so that retrying them fails without a search until the lattice around
+ * them changes. A failure only depends on the free cells reachable from the source, the occupied cells bordering them
+ * and the boundaries of the source and target patches, so each failure keeps the versions of the tiles covering those
+ * (see RegionVersions) and stays valid while none of them changes. Only works on slices that expose region versions.
+ * Versions of different slices can't be compared, so the failures are forgotten whenever a query is on another slice.
+ */
+class NegativeRouteCache
+{
+public:
+    static constexpr size_t default_capacity = 1024;
+
+    explicit NegativeRouteCache(size_t capacity = default_capacity) : capacity_(capacity) {}
+
+    bool known_to_fail(const Slice& slice, const RouteQuery& query);
+    void remember_failure(const Slice& slice, const RouteQuery& query);
+
+    struct Stats {
+        size_t hits = 0;
+        size_t remembered = 0;
+        size_t invalidations = 0;
+    };
+    const Stats& stats() const {return stats_;}
+
+private:
+    using Footprint = std::vector<std::pair<size_t, RegionVersions::Version>>;
+
+    // Forgets the failures if they were remembered on a slice other than the one with these versions
+    void use_versions_of(const RegionVersions& versions);
+    void collect_footprint(const Slice& slice, const RegionVersions& versions, const RouteQuery& query,
+                           Footprint& footprint);
+
+    size_t capacity_;
+    std::unordered_map<RouteQuery, Footprint, RouteQuery::hash> failures_;
+    // RegionVersions::id of the slice the failures were found on
+    std::optional<RegionVersions::Id> versions_id_;
+    Stats stats_;
+
+    // Scratch for collect_footprint
+    std::vector<uint32_t> visited_;
+    uint32_t generation_ = 0;
+    std::vector<Cell> queue_;
+    std::vector<bool> tile_in_footprint_;
+};
+
+
+std::ostream& operator<<(std::ostream& os, const NegativeRouteCache::Stats& stats);
+
+}
+
+#endif //LSQECC_NEGATIVE_ROUTE_CACHE_HPP
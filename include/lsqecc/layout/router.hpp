@@ -3,7 +3,15 @@
 
 #include <lsqecc/patches/sparse_slice.hpp>
 #include <lsqecc/patches/slice.hpp>
+#include <lsqecc/layout/graph_search/boost_based_graph_search.hpp>
+#include <lsqecc/layout/graph_search/custom_graph_search.hpp>
+#include <lsqecc/layout/graph_search/bitboard_graph_search.hpp>
+#include <lsqecc/layout/negative_route_cache.hpp>
 
+#include <lstk/lstk.hpp>
+
+#include <list>
+#include <ostream>
 #include <unordered_map>
 
 namespace lsqecc {
@@ -11,8 +19,12 @@ namespace lsqecc {
 enum class GraphSearchProvider
 {
     Boost,
+    BoostIncremental, // Boost's Djikstra over a graph kept up to date between searches
     Djikstra,
-    AStar
+    AStar,
+    BucketAStar, // A* with a Manhattan heuristic over a bucket queue
+    Bitboard, // Word parallel BFS over the free cells
+    LandmarkAStar, // A* with landmark distance lower bounds from Layout::static_distances
 };
 
 
@@ -27,6 +39,9 @@ struct Router {
 
     virtual void set_graph_search_provider(GraphSearchProvider graph_search_provider) = 0;
 
+    // Routers that keep statistics (e.g. cache hit rates) print them here, for -f stats
+    virtual void print_stats(std::ostream& os) const {LSTK_UNUSED(os);}
+
     virtual ~Router(){};
 };
 
@@ -45,19 +60,39 @@ struct CustomDPRouter : public Router
         graph_search_provider_ = graph_search_provider;
     };
 
+    void print_stats(std::ostream& os) const override;
+
+    const NegativeRouteCache::Stats& negative_route_cache_stats() const {return negative_route_cache_.stats();}
+
 private:
+    std::optional<RoutingRegion> search(
+            const Slice& slice,
+            PatchId source,
+            PauliOperator source_op,
+            PatchId target,
+            PauliOperator target_op
+    ) const;
+
     GraphSearchProvider graph_search_provider_ = GraphSearchProvider::Djikstra;
+    mutable custom_graph_search::SearchWorkspace search_workspace_;
+    mutable bitboard_graph_search::BitboardSearchWorkspace bitboard_search_workspace_;
+    mutable boost_graph_search::IncrementalGraph boost_incremental_graph_;
+    mutable NegativeRouteCache negative_route_cache_;
 
 };
 
 /**
- * Assumes paths are always clear. If a new patch appears on a previous route, route will go right over it.
- * TODO: Fix that by checking that the path is clear. Will require caching occupied cells
+ * Reuses recently found routes between the same cells and operators, keeping at most capacity of them (least recently
+ * used are evicted first). A cached route is only returned if all its cells are still free and the patches still
+ * expose the requested boundaries towards it, otherwise it is dropped and searched for again.
  *
- * Also assumes that all patches are LayoutHelpers::basic_square_patch
+ * Assumes that all patches are LayoutHelpers::basic_square_patch
  */
 struct CachedRouter : public Router
 {
+    static constexpr size_t default_capacity = 4096;
+
+    explicit CachedRouter(size_t capacity = default_capacity);
 
     std::optional<RoutingRegion> find_routing_ancilla(
             const Slice& slice,
@@ -72,24 +107,29 @@ struct CachedRouter : public Router
         router_impl_.set_graph_search_provider(graph_search_provider);
     };
 
-    struct PathIdentifier {
-        Cell source_cell;
-        PauliOperator source_op;
-        Cell target_cell;
-        PauliOperator target_op;
-
-        bool operator==(const PathIdentifier&) const = default;
-        struct hash
-        {
-            size_t operator()( const PathIdentifier& x ) const;
-        };
+    void print_stats(std::ostream& os) const override;
+
+    using PathIdentifier = RouteQuery;
+
+    struct CacheStats {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t invalidations = 0;
+        size_t evictions = 0;
     };
+    const CacheStats& cache_stats() const {return stats_;}
 
 
 private:
 
     CustomDPRouter router_impl_;
-    mutable std::unordered_map<PathIdentifier, RoutingRegion, PathIdentifier::hash> cached_routes_;
+    size_t capacity_;
+
+    // Most recently used first
+    using LruList = std::list<std::pair<PathIdentifier, RoutingRegion>>;
+    mutable LruList lru_routes_;
+    mutable std::unordered_map<PathIdentifier, LruList::iterator, PathIdentifier::hash> cached_routes_;
+    mutable CacheStats stats_;
 };
 }
 
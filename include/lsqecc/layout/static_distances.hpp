@@ -0,0 +1,108 @@
+#ifndef LSQECC_STATIC_DISTANCES_HPP
+#define LSQECC_STATIC_DISTANCES_HPP
+
+#include <lsqecc/patches/patches.hpp>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace lsqecc {
+
+struct Layout;
+
+
+// Hop counts from a set of cells to every cell of the lattice, walking only over cells that are never permanently
+// occupied
+class DistanceField
+{
+public:
+    using Distance = uint32_t;
+    static constexpr Distance unreachable = std::numeric_limits<Distance>::max();
+
+    DistanceField() = default;
+    DistanceField(size_t cols, std::vector<Distance> distances)
+        : cols_(cols), distances_(std::move(distances))
+    {}
+
+    Distance at(const Cell& cell) const
+    {
+        return distances_[static_cast<size_t>(cell.row)*cols_ + static_cast<size_t>(cell.col)];
+    }
+
+private:
+    size_t cols_ = 0;
+    std::vector<Distance> distances_;
+};
+
+
+/*
+ * Distances over the empty lattice of a layout, i.e. with only the cells that can never be routed through (dead
+ * cells and distillation regions) blocked. Routes on any slice of the layout are at least as long, so these give
+ * admissible A* heuristics and rule out impossible routes without searching.
+ *
+ * Lower bounds between arbitrary cells come from landmark distance fields (ALT): for any landmark L,
+ * |d(L,a) - d(L,b)| <= d(a,b) by the triangle inequality.
+ */
+class StaticDistances
+{
+public:
+    static constexpr size_t default_num_landmarks = 8;
+    static constexpr size_t max_landmarks = 16;
+
+    explicit StaticDistances(const Layout& layout, size_t num_landmarks = default_num_landmarks);
+
+    bool is_blocked(const Cell& cell) const {return components_[index_of(cell)] == blocked;}
+
+    // False only if no slice of the layout can have a route between a and b, e.g. when they are on different sides of
+    // a wall of dead cells. Cells that are blocked themselves are assumed to be reachable
+    bool may_be_connected(const Cell& a, const Cell& b) const;
+
+    // Admissible, consistent estimate of the number of hops from any cell to a fixed target
+    class TargetHeuristic
+    {
+    public:
+        DistanceField::Distance operator()(const Cell& cell) const;
+
+    private:
+        friend class StaticDistances;
+        TargetHeuristic(const StaticDistances& distances, const Cell& target);
+
+        const StaticDistances& distances_;
+        Cell target_;
+        std::array<DistanceField::Distance, max_landmarks> landmark_to_target_;
+    };
+    TargetHeuristic heuristic_to(const Cell& target) const {return TargetHeuristic{*this, target};}
+
+    DistanceField::Distance lower_bound(const Cell& a, const Cell& b) const {return heuristic_to(b)(a);}
+
+    // Distances from each predistilled Y state, in the order of Layout::predistilled_y_states. Only kept when they fit
+    // in max_y_state_field_entries, as layouts with many Y states would otherwise need one field per Y state
+    static constexpr size_t max_y_state_field_entries = size_t{1} << 22;
+    bool has_y_state_fields() const {return !y_state_fields_.empty();}
+    const DistanceField& from_y_state(size_t y_state_idx) const {return y_state_fields_[y_state_idx];}
+
+    size_t num_landmarks() const {return landmark_fields_.size();}
+
+private:
+    static constexpr uint32_t blocked = std::numeric_limits<uint32_t>::max();
+
+    size_t index_of(const Cell& cell) const
+    {
+        return static_cast<size_t>(cell.row)*cols_ + static_cast<size_t>(cell.col);
+    }
+    DistanceField breadth_first_distances(const std::vector<Cell>& sources) const;
+
+    size_t rows_;
+    size_t cols_;
+    // Connected component of each cell over the unblocked cells, or blocked
+    std::vector<uint32_t> components_;
+    std::vector<DistanceField> landmark_fields_;
+    std::vector<DistanceField> y_state_fields_;
+};
+
+}
+
+#endif //LSQECC_STATIC_DISTANCES_HPP
@@ -0,0 +1,93 @@
+#ifndef LSQECC_COMPACT_LS_INSTRUCTION_HPP
+#define LSQECC_COMPACT_LS_INSTRUCTION_HPP
+
+#include <lsqecc/ls_instructions/ls_instructions.hpp>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace lsqecc {
+
+
+/**
+ * Holds the instructions that don't fit in a CompactLSInstruction. Handles of taken payloads are reused.
+ */
+class LSInstructionPayloads
+{
+public:
+    using Handle = uint32_t;
+
+    Handle store(LSInstruction&& instruction);
+
+    // Moves the instruction out and frees its handle
+    LSInstruction take(Handle handle);
+
+    const LSInstruction& at(Handle handle) const;
+
+    size_t size() const {return size_;}
+
+private:
+    std::vector<std::optional<LSInstruction>> payloads_;
+    std::vector<Handle> free_handles_;
+    size_t size_ = 0;
+};
+
+
+/**
+ * Fixed size, trivially copyable encoding of an LSInstruction, for buffering instructions without the allocations of
+ * the maps, sets and vectors that LSInstruction alternatives own.
+ *
+ * Measurements on up to max_inline_patches patches and all single patch instructions are stored inline. The rest
+ * (declarations, Bell pairs, busy regions and larger measurements) are moved into an LSInstructionPayloads and only
+ * their handle is kept.
+ */
+struct CompactLSInstruction
+{
+    static constexpr size_t max_inline_patches = 2;
+
+    enum class Kind : uint8_t {
+        SinglePatchMeasurement,
+        MultiPatchMeasurement,
+        PatchInit,
+        MagicStateRequest,
+        YStateRequest,
+        SingleQubitOp,
+        RotateSingleCellPatch,
+        Payload
+    };
+
+    enum Flags : uint8_t {
+        is_negative = 1,        // Measurements
+        is_dagger = 2,          // SingleQubitOp
+        init_plus = 4,          // PatchInit
+        has_place_next_to = 8,  // PatchInit, with the neighbour in patches[1] and its operator in paulis[1]
+    };
+
+    Kind kind = Kind::Payload;
+    uint8_t flags = 0;
+    uint8_t num_patches = 0;
+    SingleQubitOp::Operator gate = SingleQubitOp::Operator::X;
+    std::array<PauliOperator, max_inline_patches> paulis{};
+    std::array<PatchId, max_inline_patches> patches{}; // Target first. YStateRequest keeps near_patch second
+    uint32_t wait_at_most_for = 0;
+    LSInstructionPayloads::Handle payload = 0;
+
+    // Whether from stores the instruction without touching payloads
+    static bool fits_inline(const LSInstruction& instruction);
+
+    static CompactLSInstruction from(LSInstruction&& instruction, LSInstructionPayloads& payloads);
+
+    // Takes the payload back out of payloads, so each compact instruction can only be converted once
+    LSInstruction to_instruction(LSInstructionPayloads& payloads) const;
+};
+
+static_assert(std::is_trivially_copyable_v<CompactLSInstruction>);
+
+
+} // namespace lsqecc
+
+
+#endif //LSQECC_COMPACT_LS_INSTRUCTION_HPP
@@ -14,6 +14,7 @@
 #include <iterator>
 #include <cstddef>
 #include <queue>
+#include <vector>
 
 namespace lsqecc {
 
@@ -72,6 +73,22 @@ private:
 };
 
 
+// Instructions that were read ahead, e.g. to slice them more than once
+class LSInstructionStreamFromVector : public LSInstructionStream {
+public:
+    LSInstructionStreamFromVector(std::vector<LSInstruction> instructions, tsl::ordered_set<PatchId> core_qubits);
+
+    LSInstruction get_next_instruction() override;
+    bool has_next_instruction() const override {return next_instruction_ < instructions_.size();};
+    const tsl::ordered_set<PatchId>& core_qubits() const override {return core_qubits_;}
+
+private:
+    std::vector<LSInstruction> instructions_;
+    size_t next_instruction_ = 0;
+    tsl::ordered_set<PatchId> core_qubits_;
+};
+
+
 std::ostream& print_all_ls_instructions_to_string(std::ostream& os, std::unique_ptr<LSInstructionStream>&& ls_instruction_stream);
 
 
@@ -135,6 +135,10 @@ struct LSInstruction {
 
     size_t wait_at_most_for = DEFAULT_MAX_WAIT;
 
+    using OperatingPatches = lstk::SmallVector<PatchId, 4>;
+
+    // Same patches in the same order as get_operating_patches, without allocating for up to four patches
+    OperatingPatches operating_patches() const;
     tsl::ordered_set<PatchId> get_operating_patches() const;
     bool operator==(const LSInstruction&) const = default;
 };
@@ -247,12 +251,68 @@ static inline std::string_view SingleQuibitOperatorName_to_string(SingleQubitOp:
 
 namespace dag {
 
+template<>
+struct LocalCommutationTrait<LSInstruction>
+{
+    using Resource = PatchId;
+
+    // Multi patch measurements and Pauli and S corrections commute on patches where they are all diagonal in the same
+    // Pauli basis. Everything else, including single patch measurements which consume their patch, is exclusive
+    template<typename F>
+    static void for_each_access(const LSInstruction& instruction, F&& f)
+    {
+        if (const auto* m = std::get_if<MultiPatchMeasurement>(&instruction.operation))
+        {
+            for (const auto& [patch, op]: m->observable)
+                f(patch, diagonal_in(op));
+        }
+        else if (const auto* g = std::get_if<SingleQubitOp>(&instruction.operation))
+        {
+            f(g->target, diagonal_in(basis_of(g->op)));
+        }
+        else
+        {
+            for (PatchId patch: instruction.operating_patches())
+                f(patch, exclusive_access);
+        }
+    }
+
+    // PauliOperator::I for operators that aren't diagonal in any Pauli basis, or that LogicalPauli cast from a
+    // PauliOperator without an Operator of its own
+    static PauliOperator basis_of(SingleQubitOp::Operator op)
+    {
+        switch(op)
+        {
+            case SingleQubitOp::Operator::X: return PauliOperator::X;
+            case SingleQubitOp::Operator::Z:
+            case SingleQubitOp::Operator::S: return PauliOperator::Z;
+            default: return PauliOperator::I;
+        }
+    }
+};
+
 template<>
 struct CommutationTrait<LSInstruction>
 {
     static bool can_commute(const LSInstruction& a, const LSInstruction& b)
     {
-        return lstk::set_intersection(a.get_operating_patches(), b.get_operating_patches()).empty();
+        // Pauli measurements commute when their observables anticommute on an even number of patches, even if they
+        // don't agree patch by patch
+        const auto* ma = std::get_if<MultiPatchMeasurement>(&a.operation);
+        const auto* mb = std::get_if<MultiPatchMeasurement>(&b.operation);
+        if (ma && mb)
+        {
+            size_t anticommuting = 0;
+            for (const auto& [patch, op]: ma->observable)
+            {
+                auto it = mb->observable.find(patch);
+                if (it != mb->observable.end() && op != PauliOperator::I && it->second != PauliOperator::I
+                    && op != it->second)
+                    anticommuting++;
+            }
+            return anticommuting % 2 == 0;
+        }
+        return accesses_commute(a, b);
     }
 };
 
@@ -0,0 +1,61 @@
+#ifndef LSQECC_THREADED_LS_INSTRUCTION_STREAM_HPP
+#define LSQECC_THREADED_LS_INSTRUCTION_STREAM_HPP
+
+#include <lsqecc/ls_instructions/compact_ls_instruction.hpp>
+#include <lsqecc/ls_instructions/ls_instruction_stream.hpp>
+#include <lsqecc/pipelines/spsc_queue.hpp>
+
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace lsqecc
+{
+
+/**
+ * Pulls instructions from source on a thread of its own, so that parsing and instruction generation run ahead of the
+ * slicer. Instructions come out in the same order as from source, and errors from source are rethrown from
+ * has_next_instruction or get_next_instruction once the instructions before them are consumed.
+ *
+ * Instructions are queued as CompactLSInstruction, those that don't fit inline go through a payload table shared by
+ * the two threads.
+ *
+ * Source, and whatever it refers to (gate streams, the id generator, the layout), must only be used by this stream
+ * and must outlive it. If no thread can be started, source is read inline.
+ */
+class ThreadedLSInstructionStream : public LSInstructionStream
+{
+public:
+    static constexpr size_t default_queue_capacity = 4096;
+
+    explicit ThreadedLSInstructionStream(
+            std::unique_ptr<LSInstructionStream>&& source,
+            size_t queue_capacity = default_queue_capacity);
+
+    ~ThreadedLSInstructionStream() override;
+
+    LSInstruction get_next_instruction() override;
+
+    // Blocks until the producer thread has the next instruction or is done
+    bool has_next_instruction() const override;
+
+    const tsl::ordered_set<PatchId>& core_qubits() const override {return core_qubits_;}
+
+    bool is_threaded() const {return producer_.joinable();}
+
+private:
+    void produce();
+
+    std::unique_ptr<LSInstructionStream> source_;
+    tsl::ordered_set<PatchId> core_qubits_;
+    std::unique_ptr<SpscQueue<CompactLSInstruction>> queue_;
+    LSInstructionPayloads payloads_; // Guarded by payloads_mutex_
+    std::mutex payloads_mutex_;
+    std::exception_ptr source_error_; // Written by the producer before it closes the queue
+    std::thread producer_;
+};
+
+}
+
+#endif //LSQECC_THREADED_LS_INSTRUCTION_STREAM_HPP
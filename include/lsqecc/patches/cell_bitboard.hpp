@@ -0,0 +1,88 @@
+#ifndef LSQECC_CELL_BITBOARD_HPP
+#define LSQECC_CELL_BITBOARD_HPP
+
+#include <lsqecc/patches/patches.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace lsqecc
+{
+
+/*
+ * One bit per cell of a rows x cols lattice, stored row by row with 64 cells per word. Bit i of word w in a row is
+ * column 64*w+i. Bits past the last column are always zero, so rows can be shifted and combined a word at a time.
+ */
+class CellBitboard
+{
+public:
+    using Word = uint64_t;
+    static constexpr size_t bits_per_word = 64;
+
+    CellBitboard() = default;
+    CellBitboard(size_t rows, size_t cols, bool value = false)
+        : rows_(rows),
+          cols_(cols),
+          words_per_row_((cols + bits_per_word - 1) / bits_per_word),
+          words_(rows_*words_per_row_, 0)
+    {
+        if(value) fill(true);
+    }
+
+    size_t rows() const {return rows_;}
+    size_t cols() const {return cols_;}
+    size_t words_per_row() const {return words_per_row_;}
+
+    bool test(const Cell& cell) const
+    {
+        return (row(cell.row)[cell.col / bits_per_word] >> (cell.col % bits_per_word)) & 1;
+    }
+
+    void set(const Cell& cell, bool value)
+    {
+        Word& w = row(cell.row)[cell.col / bits_per_word];
+        const Word bit = Word{1} << (cell.col % bits_per_word);
+        w = value ? (w | bit) : (w & ~bit);
+    }
+
+    void fill(bool value)
+    {
+        if(!value)
+        {
+            std::fill(words_.begin(), words_.end(), 0);
+            return;
+        }
+        for(size_t r = 0; r < rows_; r++)
+        {
+            Word* words = row(r);
+            std::fill(words, words + words_per_row_, ~Word{0});
+            if(cols_ % bits_per_word)
+                words[words_per_row_-1] = (Word{1} << (cols_ % bits_per_word)) - 1;
+        }
+    }
+
+    // Resizes if needed and clears every bit
+    void reset(size_t rows, size_t cols)
+    {
+        if(rows != rows_ || cols != cols_)
+            *this = CellBitboard{rows, cols};
+        else
+            fill(false);
+    }
+
+    Word* row(size_t r) {return words_.data() + r*words_per_row_;}
+    const Word* row(size_t r) const {return words_.data() + r*words_per_row_;}
+
+    bool operator==(const CellBitboard&) const = default;
+
+private:
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    size_t words_per_row_ = 0;
+    std::vector<Word> words_;
+};
+
+}
+
+#endif //LSQECC_CELL_BITBOARD_HPP
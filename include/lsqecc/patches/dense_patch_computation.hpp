@@ -15,12 +15,22 @@
 
 #include <chrono>
 #include <functional>
+#include <optional>
 
 namespace lsqecc {
 
 using DenseSliceVisitor = std::function<void(const DenseSlice& slice)>;
 using LSInstructionVisitor = std::function<void(const LSInstruction& slice)>;
 
+enum class DagScheduler
+{
+    LabelOrder,   // Ready instructions are tried in the order they were read
+    CriticalPath, // Ready instructions starting the longest chains of dependants are tried first
+};
+
+std::ostream& operator<<(std::ostream& os, DagScheduler scheduler);
+
+
 struct DensePatchComputationResult : public PatchComputationResult {
     using PatchComputationResult::PatchComputationResult;
 
@@ -28,15 +38,29 @@ struct DensePatchComputationResult : public PatchComputationResult {
 
     size_t ls_instructions_count_ = 0;
     size_t slice_count_ = 1;
+    // Set by the dag pipeline
+    std::optional<DagScheduler> dag_scheduler_;
+    // Slices the dag pipeline took with label order on the same input, to compare other schedulers against
+    std::optional<size_t> label_order_slice_count_;
 
     size_t ls_instructions_count() const override {return ls_instructions_count_;}
     size_t slice_count() const override {return slice_count_;}
+
+    void print_stats(std::ostream& os) const override;
+};
+
+
+struct DagPipelineOptions
+{
+    std::optional<size_t> window; // Maximum instructions in the dag at once, the whole stream if not set
+    DagScheduler scheduler = DagScheduler::LabelOrder;
 };
 
 
 DensePatchComputationResult run_through_dense_slices(
         LSInstructionStream&& instruction_stream,
         bool dag_pipeline,
+        const DagPipelineOptions& dag_options,
         bool local_instructions,
         const Layout& layout,
         Router& router,
@@ -46,6 +70,7 @@ DensePatchComputationResult run_through_dense_slices(
         bool graceful);
 
 
+// Failed attempts of a ready instruction only count in slices where nothing could be applied
 static constexpr size_t MAX_INSTRUCTION_APPLICATION_RETRIES_DAG_PIPELINE = 100;
 
 
@@ -4,8 +4,10 @@
 #include <lsqecc/patches/patches.hpp>
 #include <lsqecc/layout/layout.hpp>
 #include <lsqecc/patches/slice.hpp>
+#include <lsqecc/patches/packed_cell.hpp>
 
 #include <functional>
+#include <limits>
 #include <unordered_map>
 #include <tsl/ordered_set.h>
 
@@ -14,12 +16,15 @@ namespace lsqecc
 
 
 
+struct DenseSliceSnapshot;
+
 struct DenseSlice : public Slice
 {
     using Slice::Slice;
 
-    using RowStore = std::vector<std::optional<DensePatch>>;
-    std::vector<RowStore> cells;
+    // Marks cells without a bound patch in the id array
+    static constexpr PatchId no_patch_id = std::numeric_limits<PatchId>::max();
+
     std::queue<Cell> magic_state_queue;
     DistillationTimeMap time_to_next_magic_state_by_distillation_region;
     std::reference_wrapper<const Layout> layout;
@@ -29,24 +34,26 @@ struct DenseSlice : public Slice
 
     virtual const Layout& get_layout() const override;
 
-    using CellTraversalFunctor
-        = std::function<void(const Cell&, std::optional<DensePatch>&)>;
     using CellTraversalConstFunctor
         = std::function<void(const Cell&, const std::optional<DensePatch>&)>;
-    void traverse_cells_mut(const CellTraversalFunctor& f);
     void traverse_cells(const CellTraversalConstFunctor& f) const;
 
-    std::optional<std::reference_wrapper<DensePatch>> get_patch_by_id(PatchId id);
-    std::optional<std::reference_wrapper<const DensePatch>> get_patch_by_id(PatchId id) const;
+    DenseSliceSnapshot snapshot() const;
+
+    std::optional<DensePatch> get_patch_by_id(PatchId id) const;
     std::optional<SparsePatch> get_sparse_patch_by_id(PatchId id) const;
     std::optional<Cell> get_cell_by_id(PatchId id) const override;
     bool has_patch(PatchId id) const override;
-    std::optional<DensePatch>& patch_at(const Cell& cell);
-    const std::optional<DensePatch>& patch_at(const Cell& cell) const;
 
-    std::optional<std::reference_wrapper<Boundary>> get_boundary_between(const Cell& target, const Cell& neighbour);
-    std::reference_wrapper<Boundary> get_boundary_between_or_fail(const Cell& target, const Cell& neighbour);
-    std::optional<std::reference_wrapper<const Boundary>> get_boundary_between(const Cell& target, const Cell& neighbour) const;
+    // Patches are stored packed, so these hand out copies. Use the mutators below to change the lattice
+    std::optional<DensePatch> patch_at(const Cell& cell) const;
+    const PackedCell& packed_cell_at(const Cell& cell) const;
+    // Row major, one entry per cell of the layout's bounding box
+    const std::vector<PackedCell>& packed_cells() const;
+    // Row major like packed_cells, no_patch_id where no patch is bound
+    const std::vector<PatchId>& patch_ids() const {return ids_;}
+
+    std::optional<Boundary> get_boundary_between(const Cell& target, const Cell& neighbour) const;
     bool have_boundary_of_type_with(const Cell& target, const Cell& neighbour, PauliOperator op) const override;
 
     // Return a cell of the placed patch
@@ -55,11 +62,89 @@ struct DenseSlice : public Slice
 
     void delete_patch_by_id(PatchId id);
 
+    // Mutations that bind, unbind or remove patch ids must go through these so that the id index stays up to date
+    void set_patch_id(const Cell& cell, std::optional<PatchId> id);
+    void set_patch(const Cell& cell, const DensePatch& patch);
+    void clear_cell(const Cell& cell);
+
+    // These throw if there is no patch at the cell
+    void set_patch_activity(const Cell& cell, PatchActivity activity);
+    void set_patch_boundaries(const Cell& cell, const CellBoundaries& boundaries);
+    void activate_boundary_between(const Cell& target, const Cell& neighbour);
+
+    // Ends the current time step: deactivates boundaries and unitaries and removes routing and measured patches.
+    // Only visits the cells that the mutators above marked dirty during this time step
+    void clear_transient_patches();
+    // Same as clear_transient_patches but visits every cell. Kept as a reference for checks and benchmarks
+    void clear_transient_patches_full_sweep();
+
+    // Row major indices of the cells that the mutators above touched since the last clear_changed_cells, without
+    // duplicates and in no particular order. run_through_dense_slices clears them after visiting each slice, so that
+    // visitors see what changed since the previous slice. A touched cell may have been changed back
+    const std::vector<size_t>& changed_cells() const {return changed_cells_;}
+    void clear_changed_cells();
+
+    // Throws if the id index disagrees with a full scan of the lattice
+    void verify_patch_id_index() const;
+    // Throws if a routing patch, a measured or unitary patch or an active boundary is left on the lattice
+    void verify_no_transient_state() const;
+
     bool is_cell_free(const Cell& cell) const override;
 
     std::vector<Cell> get_neigbours_within_slice(const Cell& cell) const override;
 
     SurfaceCodeTimestep time_to_next_magic_state(size_t distillation_region_id) const override;
+
+    const CellBitboard* free_cell_bitboard() const override;
+    const RegionVersions* region_versions() const override;
+
+private:
+    size_t index_of(const Cell& cell) const {return static_cast<size_t>(cell.row)*width_ + static_cast<size_t>(cell.col);}
+    bool is_within_slice(const Cell& cell) const;
+    // index_of for cells that come from callers, throws std::out_of_range for cells outside of the slice
+    size_t checked_index_of(const Cell& cell) const;
+    PackedCell& occupied_packed_cell_at(const Cell& cell);
+    void index_patch_id(const Cell& cell);
+    void unindex_patch_id(const Cell& cell);
+    void mark_dirty_if_transient(size_t index);
+    void mark_changed(size_t index);
+    void clear_transient_state_at(size_t index);
+    void bump_region_if_changed(const Cell& cell, uint16_t previous_routing_state);
+
+    size_t width_;
+    std::vector<PackedCell> cells_;
+    std::vector<PatchId> ids_;
+    CellBitboard free_cells_;
+    RegionVersions region_versions_;
+
+    // Cells that may hold state that clear_transient_patches has to undo, with a flag per cell to avoid duplicates
+    std::vector<size_t> dirty_cells_;
+    std::vector<bool> is_dirty_;
+
+    // Cells touched since clear_changed_cells, with a flag per cell like the dirty cells
+    std::vector<size_t> changed_cells_;
+    std::vector<bool> is_changed_;
+
+    // Where each bound patch id currently lives, so that lookups by id don't need to scan the lattice
+    std::unordered_map<PatchId, Cell> patch_id_index_;
+};
+
+
+/**
+ * The parts of a DenseSlice that are needed to draw it: packed cells, patch ids and distillation timers. Much cheaper
+ * to take than a copy of the slice, and can be read on another thread while slicing goes on
+ */
+struct DenseSliceSnapshot
+{
+    std::reference_wrapper<const Layout> layout;
+    size_t width;
+    std::vector<PackedCell> cells;
+    std::vector<PatchId> ids; // DenseSlice::no_patch_id where no patch is bound
+    DistillationTimeMap time_to_next_magic_state_by_distillation_region;
+
+    const Layout& get_layout() const {return layout.get();}
+    void traverse_cells(const DenseSlice::CellTraversalConstFunctor& f) const;
+    SurfaceCodeTimestep time_to_next_magic_state(size_t distillation_region_id) const;
 };
 
 }
@@ -0,0 +1,135 @@
+#ifndef LSQECC_PACKED_CELL_HPP
+#define LSQECC_PACKED_CELL_HPP
+
+#include <lsqecc/patches/patches.hpp>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace lsqecc
+{
+
+enum class CellSide : uint8_t {
+    Top,
+    Bottom,
+    Left,
+    Right
+};
+
+inline constexpr std::array<CellSide,4> all_cell_sides{CellSide::Top, CellSide::Bottom, CellSide::Left, CellSide::Right};
+
+
+/*
+ * Everything a DensePatch holds apart from its id, packed into three bytes. DenseSlice keeps one of these per cell
+ * in a flat row major buffer and the ids in a parallel array.
+ */
+class PackedCell
+{
+public:
+    PackedCell() = default;
+
+    static PackedCell from_dense_patch(const DensePatch& patch)
+    {
+        PackedCell c;
+        c.state_ = occupied_bit
+                   | static_cast<uint8_t>(static_cast<uint8_t>(patch.type) << type_shift)
+                   | static_cast<uint8_t>(patch.activity);
+        c.set_boundary(CellSide::Top, patch.boundaries.top);
+        c.set_boundary(CellSide::Bottom, patch.boundaries.bottom);
+        c.set_boundary(CellSide::Left, patch.boundaries.left);
+        c.set_boundary(CellSide::Right, patch.boundaries.right);
+        return c;
+    }
+
+    std::optional<DensePatch> to_dense_patch(std::optional<PatchId> id) const
+    {
+        if(!is_occupied()) return std::nullopt;
+        return DensePatch{
+                Patch{type(), activity(), id},
+                CellBoundaries{
+                        boundary(CellSide::Top),
+                        boundary(CellSide::Bottom),
+                        boundary(CellSide::Left),
+                        boundary(CellSide::Right)}};
+    }
+
+    bool is_occupied() const {return state_ & occupied_bit;}
+    PatchType type() const {return static_cast<PatchType>((state_ >> type_shift) & field_mask);}
+    PatchActivity activity() const {return static_cast<PatchActivity>(state_ & field_mask);}
+
+    void set_activity(PatchActivity activity)
+    {
+        state_ = static_cast<uint8_t>((state_ & ~field_mask) | static_cast<uint8_t>(activity));
+    }
+
+    Boundary boundary(CellSide side) const
+    {
+        const auto s = static_cast<uint8_t>(side);
+        return Boundary{
+                static_cast<BoundaryType>((boundary_types_ >> (2*s)) & 0b11),
+                static_cast<bool>((boundary_activity_ >> s) & 1)};
+    }
+
+    void set_boundary(CellSide side, const Boundary& boundary)
+    {
+        const auto s = static_cast<uint8_t>(side);
+        boundary_types_ = static_cast<uint8_t>((boundary_types_ & ~(0b11 << (2*s)))
+                                               | (static_cast<uint8_t>(boundary.boundary_type) << (2*s)));
+        set_boundary_active(side, boundary.is_active);
+    }
+
+    void set_boundary_active(CellSide side, bool active)
+    {
+        const auto s = static_cast<uint8_t>(side);
+        boundary_activity_ = static_cast<uint8_t>(active ? boundary_activity_ | (1 << s) : boundary_activity_ & ~(1 << s));
+    }
+
+    bool has_active_boundary() const {return boundary_activity_ != 0;}
+
+    // Everything about the cell that routes depend on: whether it is occupied and its boundary types
+    uint16_t routing_state() const
+    {
+        return static_cast<uint16_t>(((state_ & occupied_bit) << 1) | boundary_types_);
+    }
+    void clear_boundary_activity() {boundary_activity_ = 0;}
+
+    // The whole cell as one number, for tables keyed on cell states
+    uint32_t bits() const
+    {
+        return static_cast<uint32_t>(state_) << 16 | static_cast<uint32_t>(boundary_types_) << 8 | boundary_activity_;
+    }
+
+    // Inverse of bits, for cells read back from a file. Throws if the bits aren't those of a cell
+    static PackedCell from_bits(uint32_t bits)
+    {
+        PackedCell c;
+        c.state_ = static_cast<uint8_t>(bits >> 16);
+        c.boundary_types_ = static_cast<uint8_t>(bits >> 8);
+        c.boundary_activity_ = static_cast<uint8_t>(bits);
+        if(bits >> 24 || c.boundary_activity_ >> 4 || (c.state_ & unused_bit)
+           || c.type() > PatchType::Dead || c.activity() > PatchActivity::Dead)
+            throw std::invalid_argument("Not the bits of a cell: " + std::to_string(bits));
+        return c;
+    }
+
+    bool operator==(const PackedCell&) const = default;
+
+private:
+    static constexpr uint8_t occupied_bit = 0b1000'0000;
+    static constexpr uint8_t unused_bit = 0b0100'0000;
+    static constexpr uint8_t type_shift = 3;
+    static constexpr uint8_t field_mask = 0b111;
+
+    uint8_t state_ = 0; // occupied bit, then 3 bits of PatchType and 3 bits of PatchActivity
+    uint8_t boundary_types_ = 0; // 2 bits per side, in CellSide order
+    uint8_t boundary_activity_ = 0; // 1 bit per side, in CellSide order
+};
+
+static_assert(sizeof(PackedCell) == 3);
+
+}
+
+#endif //LSQECC_PACKED_CELL_HPP
@@ -2,6 +2,7 @@
 #define LSQECC_PATCH_COMPUTATION_RESULT_HPP
 
 #include <cstddef>
+#include <ostream>
 
 namespace lsqecc {
 
@@ -9,6 +10,9 @@ struct PatchComputationResult {
     virtual size_t ls_instructions_count() const = 0;
     virtual size_t slice_count() const = 0;
 
+    // Extra statistics of the computation, for -f stats
+    virtual void print_stats(std::ostream& os) const {(void)os;}
+
     virtual ~PatchComputationResult(){};
 };
 
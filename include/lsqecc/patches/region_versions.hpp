@@ -0,0 +1,78 @@
+#ifndef LSQECC_REGION_VERSIONS_HPP
+#define LSQECC_REGION_VERSIONS_HPP
+
+#include <lsqecc/patches/patches.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace lsqecc
+{
+
+/*
+ * Change counters for square tiles of the lattice. A slice bumps the tile of a cell whenever something a route
+ * depends on changes there, i.e. the cell becomes free or occupied or the patch on it changes boundary types. Anything
+ * computed from a set of tiles stays valid for as long as their versions do.
+ *
+ * Versions are only comparable within the same RegionVersions, as every slice starts them from 0. Each one gets an id
+ * to tell them apart, which copies don't share since they change independently of the original.
+ */
+class RegionVersions
+{
+public:
+    using Version = uint32_t;
+    using Id = uint64_t;
+    static constexpr Cell::CoordinateType tile_size = 8;
+
+    RegionVersions() = default;
+    explicit RegionVersions(const Cell& furthest_cell)
+        : tile_cols_(static_cast<size_t>(furthest_cell.col/tile_size + 1)),
+          versions_(static_cast<size_t>(furthest_cell.row/tile_size + 1)*tile_cols_, 0)
+    {}
+
+    RegionVersions(const RegionVersions& other) : tile_cols_(other.tile_cols_), versions_(other.versions_) {}
+    RegionVersions(RegionVersions&& other) noexcept
+        : tile_cols_(other.tile_cols_), versions_(std::move(other.versions_)) {}
+    RegionVersions& operator=(const RegionVersions& other)
+    {
+        tile_cols_ = other.tile_cols_;
+        versions_ = other.versions_;
+        id_ = next_id();
+        return *this;
+    }
+    RegionVersions& operator=(RegionVersions&& other) noexcept
+    {
+        tile_cols_ = other.tile_cols_;
+        versions_ = std::move(other.versions_);
+        id_ = next_id();
+        return *this;
+    }
+
+    Id id() const {return id_;}
+
+    size_t num_tiles() const {return versions_.size();}
+    size_t tile_of(const Cell& cell) const
+    {
+        return static_cast<size_t>(cell.row/tile_size)*tile_cols_ + static_cast<size_t>(cell.col/tile_size);
+    }
+
+    Version version(size_t tile) const {return versions_[tile];}
+    void bump(const Cell& cell) {versions_[tile_of(cell)]++;}
+
+private:
+    static Id next_id()
+    {
+        static std::atomic<Id> next{0};
+        return next++;
+    }
+
+    size_t tile_cols_ = 0;
+    std::vector<Version> versions_;
+    Id id_ = next_id();
+};
+
+}
+
+#endif //LSQECC_REGION_VERSIONS_HPP
@@ -2,6 +2,8 @@
 #define LSQECC_SLICE_HPP
 
 #include <lsqecc/patches/patches.hpp>
+#include <lsqecc/patches/cell_bitboard.hpp>
+#include <lsqecc/patches/region_versions.hpp>
 #include <lsqecc/layout/layout.hpp>
 
 #include <queue>
@@ -20,6 +22,12 @@ struct Slice
     virtual bool have_boundary_of_type_with(const Cell& target, const Cell& neighbour, PauliOperator op) const = 0;
     virtual SurfaceCodeTimestep time_to_next_magic_state(size_t distillation_region_id) const = 0;
 
+    // Slices that keep their free cells as a bitboard can expose it to the routers, which otherwise build their own
+    virtual const CellBitboard* free_cell_bitboard() const {return nullptr;}
+
+    // Slices that track where they change can let routers reuse results until the relevant tiles change
+    virtual const RegionVersions* region_versions() const {return nullptr;}
+
     virtual ~Slice(){};
 };
 
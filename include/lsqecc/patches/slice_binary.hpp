@@ -0,0 +1,174 @@
+#ifndef LSQECC_SLICE_BINARY_HPP
+#define LSQECC_SLICE_BINARY_HPP
+
+#include <lsqecc/patches/dense_slice.hpp>
+#include <lsqecc/patches/slices_to_json.hpp>
+
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace lsqecc {
+
+
+/*
+ * Binary format for the slices of a run, much smaller and quicker to write and read than the JSON. Little endian,
+ * with varints in LEB128:
+ *
+ *   header: "LSQSLICE", u32 version, u32 rows, u32 cols, u32 number of distillation regions and a u32 per region with
+ *           the cell that shows its timer, as given by distillation_timer_cells
+ *   records, each a u8 SliceRecordKind and then:
+ *     Keyframe: palette additions, timers, then for each cell its palette index and, if occupied, its id
+ *     Full:     like a keyframe, but the palette carries on from the previous record
+ *     Delta:    palette additions, timers, the number of cells that changed since the previous slice, then for each of
+ *               those the number of unchanged cells skipped since the previous change, its palette index and id
+ *     End:      u64 number of slices, u64 number of keyframes and for each keyframe the varint increases of its slice
+ *               number and record offset over the previous one, then the u64 offset of the End record itself as the
+ *               last 8 bytes of the file
+ *
+ * The palette maps cell states (PackedCell::bits) to small numbers. It starts over at every keyframe, so that reading
+ * can start from any keyframe, and nowhere else. Entry 0 is the empty cell and every record adds the states it uses for the first time:
+ * a varint count, then 3 bytes of bits per state. Ids are written as id+1, with 0 for no id. Timers are a varint
+ * count and a varint per distillation region. Offsets count from the start of the header.
+ */
+
+enum class SliceRecordKind : uint8_t
+{
+    Keyframe,
+    Full,
+    Delta,
+    End
+};
+
+
+class SliceBinaryWriter
+{
+public:
+    static constexpr uint32_t version = 2;
+    static constexpr size_t default_keyframe_interval = 128;
+
+    /**
+     * Writes the header. Every keyframe_interval slices are written as a keyframe, 0 only makes the first slice one.
+     * With delta_encode, the other slices are written as the cells in DenseSlice::changed_cells that differ from the
+     * previous slice, so every slice must be given to the writer and the changed cells cleared in between, as
+     * run_through_dense_slices does. When most cells changed, a keyframe is written instead.
+     */
+    SliceBinaryWriter(
+            std::ostream& os,
+            const Layout& layout,
+            bool delta_encode,
+            size_t keyframe_interval = default_keyframe_interval);
+
+    // Slices must be on the layout that the writer was made with
+    void write(const DenseSlice& slice);
+
+    // Writes the end record. Nothing can be written after this
+    void finish();
+
+private:
+    uint32_t palette_index(const PackedCell& cell);
+    void write_cell(const PackedCell& cell, PatchId id);
+    void write_keyframe(const DenseSlice& slice);
+    void write_delta(const DenseSlice& slice);
+    void write_full(const DenseSlice& slice, SliceRecordKind kind);
+    void write_record(SliceRecordKind kind, const DenseSlice& slice);
+    void write_bytes(const std::string& bytes);
+
+    std::ostream& os_;
+    bool delta_encode_;
+    size_t keyframe_interval_;
+    size_t num_cells_;
+
+    uint64_t bytes_written_ = 0;
+    uint64_t slices_written_ = 0;
+    // Slice number and offset of each keyframe
+    std::vector<std::pair<uint64_t, uint64_t>> keyframes_;
+
+    std::unordered_map<uint32_t, uint32_t> palette_;
+    std::vector<uint32_t> palette_additions_;
+
+    // What readers have for the cells so far, to leave out cells that were touched but are unchanged
+    std::vector<PackedCell> previous_cells_;
+    std::vector<PatchId> previous_ids_;
+    std::vector<size_t> changed_cells_;
+
+    // Cells of the record being written, after its palette additions and timers
+    std::string cells_buffer_;
+    std::string record_buffer_;
+};
+
+
+class SliceBinaryReader
+{
+public:
+    // Reads the header. Throws std::runtime_error if is doesn't start with slices in the binary format
+    explicit SliceBinaryReader(std::istream& is);
+
+    size_t rows() const {return rows_;}
+    size_t cols() const {return cols_;}
+    const std::vector<uint32_t>& timer_cells() const {return timer_cells_;}
+
+    // Reads the next slice, false once the end record is reached. Throws std::runtime_error on malformed input
+    bool read_next();
+
+    // These read the keyframe index at the end of the file, so they need a stream that can seek. After reading the
+    // index, read_next only goes on after a seek
+    size_t num_slices();
+    // Reads the given slice, from the keyframe before it. read_next continues with the slice after it
+    void seek(size_t slice);
+
+    // The last slice read. Row major, with DenseSlice::no_patch_id where no patch is bound
+    const std::vector<PackedCell>& cells() const {return cells_;}
+    const std::vector<PatchId>& ids() const {return ids_;}
+    const DistillationTimeMap& time_to_next_magic_state_by_distillation_region() const {return timers_;}
+
+    size_t slices_read() const {return slices_read_;}
+
+private:
+    uint8_t read_byte();
+    uint32_t read_u32();
+    uint64_t read_u64();
+    uint32_t read_varint();
+    uint64_t read_varint64();
+    void read_palette_additions();
+    void read_cell(size_t index);
+    void read_index();
+    void seek_to_offset(uint64_t offset);
+
+    std::streambuf& in_;
+    std::streampos start_;
+    size_t rows_;
+    size_t cols_;
+    std::vector<uint32_t> timer_cells_;
+    std::vector<PackedCell> palette_;
+    bool at_end_ = false;
+    size_t slices_read_ = 0;
+
+    // Slice number and offset of each keyframe, read by the first num_slices or seek
+    std::optional<uint64_t> num_slices_;
+    std::vector<std::pair<uint64_t, uint64_t>> keyframes_;
+
+    std::vector<PackedCell> cells_;
+    std::vector<PatchId> ids_;
+    DistillationTimeMap timers_;
+};
+
+
+// Writes the slices read from the binary format as the JSON that the slicer outputs. Starting past the first slice
+// seeks, so it needs a stream that can
+void binary_slices_to_json(
+        std::istream& is,
+        std::ostream& os,
+        JsonStyle style,
+        size_t first_slice = 0,
+        size_t max_slices = SIZE_MAX);
+
+
+} // namespace lsqecc
+
+#endif //LSQECC_SLICE_BINARY_HPP
@@ -0,0 +1,90 @@
+#ifndef LSQECC_SLICE_JSON_WRITER_HPP
+#define LSQECC_SLICE_JSON_WRITER_HPP
+
+#include <lsqecc/patches/dense_slice.hpp>
+#include <lsqecc/patches/slices_to_json.hpp>
+#include <lsqecc/pipelines/spsc_queue.hpp>
+
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lsqecc {
+
+
+/**
+ * Writes slices to a stream as the JSON array that the slicer outputs, one slice_to_json(slice).dump(3) per slice, or
+ * dump() in the compact style. Slices are formatted by a SliceJsonFormatter.
+ *
+ * With workers, write only takes a DenseSliceSnapshot and hands it to a worker thread, so that formatting doesn't hold
+ * up slicing. Slices are dealt to the workers in turn, each through a queue of its own. With more than one worker, a
+ * writer thread collects the formatted slices from the workers in the same turn order, so they come out in slice order
+ * and the output is the same as without workers. If no thread can be started, slices are written inline.
+ */
+class SliceJsonWriter
+{
+public:
+    static constexpr size_t default_queue_capacity = 16;
+
+    // No workers writes inline
+    SliceJsonWriter(
+            std::ostream& os,
+            size_t num_workers,
+            JsonStyle style = JsonStyle::Indented,
+            size_t queue_capacity = default_queue_capacity);
+
+    // Writes out the slices still queued, but not the closing bracket
+    ~SliceJsonWriter();
+
+    // Rethrows errors from the worker and writer threads
+    void write(const DenseSlice& slice);
+
+    // Writes out the slices still queued and closes the array. Nothing can be written after this
+    void finish();
+
+    size_t num_workers() const {return workers_.size();}
+
+private:
+    struct Worker
+    {
+        Worker(JsonStyle style, size_t queue_capacity)
+            : formatter(style), snapshots(queue_capacity), formatted_slices(queue_capacity) {}
+
+        SliceJsonFormatter formatter;
+        SpscQueue<DenseSliceSnapshot> snapshots;
+        SpscQueue<std::string> formatted_slices; // Only used with more than one worker
+        std::thread thread;
+    };
+
+    void start_threads(size_t num_workers, JsonStyle style, size_t queue_capacity);
+    void format(Worker& worker);
+    void collect();
+    void write_formatted(const std::string& formatted_slice);
+    void join();
+    void fail(std::exception_ptr error);
+    void rethrow_error();
+
+    std::ostream& os_;
+    bool is_first_slice_ = true;
+
+    // For writing inline
+    SliceJsonFormatter formatter_;
+    std::string buffer_;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    size_t next_worker_ = 0;
+    std::thread writer_;
+
+    // The first error of any thread. Every queue is cancelled when it is set, so that no thread is left waiting
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+};
+
+
+} // namespace lsqecc
+
+#endif //LSQECC_SLICE_JSON_WRITER_HPP
@@ -5,11 +5,73 @@
 #include <lsqecc/patches/sparse_slice.hpp>
 #include <nlohmann/json.hpp>
 
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace lsqecc {
 
 
 nlohmann::json slice_to_json(const SparseSlice& slices);
 nlohmann::json slice_to_json(const DenseSlice& slices);
+nlohmann::json slice_to_json(const DenseSliceSnapshot& slices);
+
+// Row major index of the cell that shows the timer of each distillation region, in region order
+std::vector<uint32_t> distillation_timer_cells(const Layout& layout);
+
+
+enum class JsonStyle : uint8_t
+{
+    Indented, // Like nlohmann::json::dump(3)
+    Compact // Like nlohmann::json::dump()
+};
+
+/**
+ * Formats dense slices as JSON text directly, without building a nlohmann::json first. The text is the same as
+ * slice_to_json(slice).dump(3), or .dump() in the compact style.
+ *
+ * Everything in a cell's JSON but its text only depends on its PackedCell, so that part is formatted once per cell
+ * state and reused. Keep one formatter per thread.
+ */
+class SliceJsonFormatter
+{
+public:
+    explicit SliceJsonFormatter(JsonStyle style = JsonStyle::Indented) : style_(style) {}
+
+    void append(std::string& out, const DenseSlice& slice);
+    void append(std::string& out, const DenseSliceSnapshot& slice);
+
+    // For slices without a layout, like those read back from the binary format. timer_cells are as given by
+    // distillation_timer_cells
+    void append(
+            std::string& out,
+            size_t width,
+            const std::vector<uint32_t>& timer_cells,
+            const std::vector<PackedCell>& cells,
+            const std::vector<PatchId>& ids,
+            const DistillationTimeMap& time_to_next_magic_state_by_distillation_region);
+
+private:
+    void append_slice(
+            std::string& out,
+            size_t width,
+            const std::vector<PackedCell>& cells,
+            const std::vector<PatchId>& ids,
+            const DistillationTimeMap& time_to_next_magic_state_by_distillation_region);
+
+    const std::string& cell_prefix(const PackedCell& cell);
+    void update_timer_cells(const Layout& layout, size_t num_cells);
+    void set_timer_cells(const std::vector<uint32_t>& timer_cells, size_t num_cells);
+
+    JsonStyle style_;
+    std::unordered_map<uint32_t, std::string> cell_prefixes_;
+
+    // For each cell of the last layout, the distillation region whose timer it shows or no_timer
+    static constexpr uint32_t no_timer = UINT32_MAX;
+    const Layout* timer_cells_layout_ = nullptr;
+    std::vector<uint32_t> timer_cells_;
+};
 
 
 template<class SliceType>
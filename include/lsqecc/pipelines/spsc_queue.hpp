@@ -0,0 +1,120 @@
+#ifndef LSQECC_SPSC_QUEUE_HPP
+#define LSQECC_SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+namespace lsqecc {
+
+
+/**
+ * Bounded lock-free queue between one producer thread and one consumer thread, used to hand work between the stages
+ * of the slicer pipeline.
+ *
+ * Each side only writes its own index, so pushing and popping never take a lock. A side that has to wait for the
+ * other (a full queue for the producer, an empty one for the consumer) spins briefly and then backs off with short
+ * sleeps, so a stalled stage doesn't hog a core that the other stages need.
+ */
+template<typename T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(size_t capacity)
+    {
+        if(capacity == 0)
+            throw std::invalid_argument("SpscQueue needs a capacity of at least 1");
+        size_t rounded = 1;
+        while(rounded < capacity) rounded *= 2;
+        mask_ = rounded - 1;
+        slots_ = std::make_unique<std::optional<T>[]>(rounded);
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    size_t capacity() const {return mask_ + 1;}
+
+    // Producer side. Blocks while the queue is full. Returns false, dropping the value, if the consumer cancelled
+    bool push(T&& value)
+    {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if(!wait_until([&]{return tail - head_.load(std::memory_order_acquire) <= mask_;}))
+            return false;
+        slots_[tail & mask_].emplace(std::move(value));
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer side. No more values will be pushed
+    void close()
+    {
+        closed_.store(true, std::memory_order_release);
+    }
+
+    // Consumer side. Blocks until there is a value to pop, returns false if the queue was closed and drained or
+    // cancelled instead
+    bool wait_for_value()
+    {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        auto has_value = [&]{return tail_.load(std::memory_order_acquire) != head;};
+        if(!wait_until([&]{return has_value() || closed_.load(std::memory_order_acquire);}))
+            return false;
+        // Values pushed before closing are visible once closed_ is
+        return has_value();
+    }
+
+    // Consumer side. Blocks like wait_for_value, std::nullopt once the queue is closed and drained or cancelled
+    std::optional<T> pop()
+    {
+        if(!wait_for_value())
+            return std::nullopt;
+        const size_t head = head_.load(std::memory_order_relaxed);
+        std::optional<T> value{std::move(slots_[head & mask_])};
+        slots_[head & mask_].reset();
+        head_.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+    // Either side. Pushes fail and pops come back empty from then on, so neither side is left waiting
+    void cancel()
+    {
+        cancelled_.store(true, std::memory_order_release);
+    }
+
+private:
+    // Returns false if the wait ended because the queue was cancelled
+    template<typename Condition>
+    bool wait_until(Condition&& condition) const
+    {
+        for(size_t attempt = 0; ; attempt++)
+        {
+            if(cancelled_.load(std::memory_order_acquire))
+                return false;
+            if(condition())
+                return true;
+            if(attempt < 64)
+                std::this_thread::yield();
+            else
+                std::this_thread::sleep_for(std::chrono::microseconds{50});
+        }
+    }
+
+    std::unique_ptr<std::optional<T>[]> slots_;
+    size_t mask_ = 0;
+
+    // On separate cache lines so that the two sides don't invalidate each other's index
+    alignas(64) std::atomic<size_t> head_ = 0;
+    alignas(64) std::atomic<size_t> tail_ = 0;
+    alignas(64) std::atomic<bool> closed_ = false;
+    std::atomic<bool> cancelled_ = false;
+};
+
+
+} // namespace lsqecc
+
+#endif //LSQECC_SPSC_QUEUE_HPP
@@ -9,6 +9,8 @@
 #define LSTK_NOOP static_cast<void>(0)
 #define LSTK_UNUSED(X) static_cast<void>(X)
 
+#include <algorithm>
+#include <array>
 #include <vector>
 #include <string>
 #include <queue>
@@ -256,6 +258,48 @@ tsl::ordered_set<T> set_intersection(const tsl::ordered_set<T>& a, const tsl::or
 }
 
 
+/**
+ * Vector that keeps up to N elements inline and only allocates once it grows past them. Meant for the handful of
+ * patches or qubits an instruction acts on, so T should be cheap to default construct and copy
+ */
+template<class T, size_t N>
+class SmallVector
+{
+public:
+    void push_back(const T& value)
+    {
+        if(size_ < N)
+            inline_[size_] = value;
+        else
+        {
+            if(size_ == N)
+                overflow_.assign(inline_.begin(), inline_.end());
+            overflow_.push_back(value);
+        }
+        size_++;
+    }
+
+    // Adds value if it isn't there yet, keeping insertion order like a tsl::ordered_set
+    void insert(const T& value)
+    {
+        if(!contains(value)) push_back(value);
+    }
+
+    bool contains(const T& value) const {return std::find(begin(), end(), value) != end();}
+
+    const T* begin() const {return size_ <= N ? inline_.data() : overflow_.data();}
+    const T* end() const {return begin() + size_;}
+    const T& operator[](size_t i) const {return begin()[i];}
+    size_t size() const {return size_;}
+    bool empty() const {return size_ == 0;}
+
+private:
+    std::array<T, N> inline_{};
+    std::vector<T> overflow_;
+    size_t size_ = 0;
+};
+
+
 // Variant visitor helper
 template<class... Ts> struct overloaded : Ts... { using Ts::operator()...; };
 template<class... Ts> overloaded(Ts...) -> overloaded<Ts...>;
@@ -48,11 +48,11 @@ BellPairInit 47 48 2:Z,44:X [Move (5,9),(6,9)];
 MultiBodyMeasure 2:Z,47:Z;MultiBodyMeasure 48:X,44:X;
 MeasureSinglePatch 47 X;MeasureSinglePatch 48 Z;HGate 44;RotateSingleCellPatch 44;
 BusyRegion (4,8),(4,9),StepsToClear(1);
-BusyRegion (4,8),(4,9),StepsToClear(0);RequestYState 44 2;RequestMagicState 49;BellPairInit 50 51 3:Z,49:X [BellPrepare (7,4),(7,5);BellPrepare (8,5),(9,5);BellPrepare (9,6),(9,7);BellPrepare (9,8),(9,9);BellPrepare (9,10),(9,11);BellPrepare (9,12),(9,13);BellPrepare (8,13),(7,13)];
-BellPairInit 50 51 3:Z,49:X [BellMeasure (7,5),(8,5);BellMeasure (9,5),(9,6);BellMeasure (9,7),(9,8);BellMeasure (9,9),(9,10);BellMeasure (9,11),(9,12);BellMeasure (9,13),(8,13);Move (7,13),(6,13)];
+BusyRegion (4,8),(4,9),StepsToClear(0);RequestYState 44 2;RequestMagicState 49;BellPairInit 50 51 3:Z,49:X [BellPrepare (5,4),(5,5);BellPrepare (5,6),(5,7);BellPrepare (5,8),(5,9);BellPrepare (5,10),(5,11)];
+BellPairInit 50 51 3:Z,49:X [BellMeasure (5,5),(5,6);BellMeasure (5,7),(5,8);BellMeasure (5,9),(5,10);Move (5,11),(6,11)];
 MultiBodyMeasure 3:Z,50:Z;MultiBodyMeasure 51:X,49:X;
-MeasureSinglePatch 50 X;MeasureSinglePatch 51 Z;MeasureSinglePatch 49 Z;RequestYState 52 3;BellPairInit 53 54 3:Z,52:X [BellPrepare (5,12),(5,11)];
-BellPairInit 53 54 3:Z,52:X [Move (5,11),(6,11)];
+MeasureSinglePatch 50 X;MeasureSinglePatch 51 Z;MeasureSinglePatch 49 Z;RequestYState 52 3;BellPairInit 53 54 3:Z,52:X [BellPrepare (5,12),(5,13)];
+BellPairInit 53 54 3:Z,52:X [Move (5,13),(6,13)];
 MultiBodyMeasure 3:Z,53:Z;MultiBodyMeasure 54:X,52:X;
 MeasureSinglePatch 53 X;MeasureSinglePatch 54 Z;HGate 52;RotateSingleCellPatch 52;
 BusyRegion (4,12),(4,13),StepsToClear(1);
@@ -61,8 +61,8 @@ BellPairInit 55 56 3:Z,52:X [Move (5,11),(6,11)];
 MultiBodyMeasure 3:Z,55:Z;MultiBodyMeasure 56:X,52:X;
 MeasureSinglePatch 55 X;MeasureSinglePatch 56 Z;HGate 52;RotateSingleCellPatch 52;
 BusyRegion (4,12),(4,13),StepsToClear(1);
-BusyRegion (4,12),(4,13),StepsToClear(0);RequestYState 52 3;RequestMagicState 57;BellPairInit 58 59 4:Z,57:X [BellPrepare (7,16),(7,15)];
-BellPairInit 58 59 4:Z,57:X [Move (7,15),(6,15)];
+BusyRegion (4,12),(4,13),StepsToClear(0);RequestYState 52 3;RequestMagicState 57;BellPairInit 58 59 4:Z,57:X [BellPrepare (5,16),(5,15)];
+BellPairInit 58 59 4:Z,57:X [Move (5,15),(6,15)];
 MultiBodyMeasure 4:Z,58:Z;MultiBodyMeasure 59:X,57:X;
 MeasureSinglePatch 58 X;MeasureSinglePatch 59 Z;MeasureSinglePatch 57 Z;RequestYState 60 4;BellPairInit 61 62 4:Z,60:X [BellPrepare (5,12),(5,13)];
 BellPairInit 61 62 4:Z,60:X [Move (5,13),(6,13)];
@@ -87,60 +87,60 @@ BellPairInit 71 72 5:Z,68:X [Move (7,5),(8,5)];
 MultiBodyMeasure 5:Z,71:Z;MultiBodyMeasure 72:X,68:X;
 MeasureSinglePatch 71 X;MeasureSinglePatch 72 Z;HGate 68;RotateSingleCellPatch 68;
 BusyRegion (8,4),(9,4),StepsToClear(1);
-BusyRegion (8,4),(9,4),StepsToClear(0);RequestYState 68 5;RequestMagicState 73;BellPairInit 74 75 6:Z,73:X [BellPrepare (11,16),(11,15);BellPrepare (11,14),(11,13);BellPrepare (11,12),(11,11);BellPrepare (11,10),(11,9);BellPrepare (10,9),(9,9)];
-BellPairInit 74 75 6:Z,73:X [BellMeasure (11,15),(11,14);BellMeasure (11,13),(11,12);BellMeasure (11,11),(11,10);BellMeasure (11,9),(10,9);Move (9,9),(8,9)];
+BusyRegion (8,4),(9,4),StepsToClear(0);RequestYState 68 5;RequestMagicState 73;BellPairInit 74 75 6:Z,73:X [BellPrepare (9,16),(9,15);BellPrepare (9,14),(9,13);BellPrepare (9,12),(9,11);BellPrepare (9,10),(9,9)];
+BellPairInit 74 75 6:Z,73:X [BellMeasure (9,15),(9,14);BellMeasure (9,13),(9,12);BellMeasure (9,11),(9,10);Move (9,9),(8,9)];
 MultiBodyMeasure 6:Z,74:Z;MultiBodyMeasure 75:X,73:X;
-MeasureSinglePatch 74 X;MeasureSinglePatch 75 Z;MeasureSinglePatch 73 Z;RequestYState 76 6;BellPairInit 77 78 6:Z,76:X [BellPrepare (5,8),(5,9);BellPrepare (6,9),(7,9);BellPrepare (7,8),(7,7)];
-BellPairInit 77 78 6:Z,76:X [BellMeasure (5,9),(6,9);BellMeasure (7,9),(7,8);Move (7,7),(8,7)];
+MeasureSinglePatch 74 X;MeasureSinglePatch 75 Z;MeasureSinglePatch 73 Z;RequestYState 76 6;BellPairInit 77 78 6:Z,76:X [BellPrepare (5,8),(5,7);BellPrepare (6,7),(7,7)];
+BellPairInit 77 78 6:Z,76:X [BellMeasure (5,7),(6,7);Move (7,7),(8,7)];
 MultiBodyMeasure 6:Z,77:Z;MultiBodyMeasure 78:X,76:X;
 MeasureSinglePatch 77 X;MeasureSinglePatch 78 Z;HGate 76;RotateSingleCellPatch 76;
 BusyRegion (4,8),(4,9),StepsToClear(1);
-BusyRegion (4,8),(4,9),StepsToClear(0);BellPairInit 79 80 6:Z,76:X [BellPrepare (5,8),(5,9);BellPrepare (6,9),(7,9)];
-BellPairInit 79 80 6:Z,76:X [BellMeasure (5,9),(6,9);Move (7,9),(8,9)];
+BusyRegion (4,8),(4,9),StepsToClear(0);BellPairInit 79 80 6:Z,76:X [BellPrepare (5,8),(5,7);BellPrepare (6,7),(7,7)];
+BellPairInit 79 80 6:Z,76:X [BellMeasure (5,7),(6,7);Move (7,7),(8,7)];
 MultiBodyMeasure 6:Z,79:Z;MultiBodyMeasure 80:X,76:X;
 MeasureSinglePatch 79 X;MeasureSinglePatch 80 Z;HGate 76;RotateSingleCellPatch 76;
 BusyRegion (4,8),(4,9),StepsToClear(1);
-BusyRegion (4,8),(4,9),StepsToClear(0);RequestYState 76 6;RequestMagicState 81;BellPairInit 82 83 7:Z,81:X [BellPrepare (13,4),(13,5);BellPrepare (13,6),(13,7);BellPrepare (12,7),(11,7);BellPrepare (11,8),(11,9);BellPrepare (11,10),(11,11);BellPrepare (10,11),(9,11)];
-BellPairInit 82 83 7:Z,81:X [BellMeasure (13,5),(13,6);BellMeasure (13,7),(12,7);BellMeasure (11,7),(11,8);BellMeasure (11,9),(11,10);BellMeasure (11,11),(10,11);Move (9,11),(8,11)];
+BusyRegion (4,8),(4,9),StepsToClear(0);RequestYState 76 6;RequestMagicState 81;BellPairInit 82 83 7:Z,81:X [BellPrepare (13,4),(13,5);BellPrepare (12,5),(11,5);BellPrepare (10,5),(9,5);BellPrepare (9,6),(9,7);BellPrepare (9,8),(9,9)];
+BellPairInit 82 83 7:Z,81:X [BellMeasure (13,5),(12,5);BellMeasure (11,5),(10,5);BellMeasure (9,5),(9,6);BellMeasure (9,7),(9,8);Move (9,9),(8,9)];
 MultiBodyMeasure 7:Z,82:Z;MultiBodyMeasure 83:X,81:X;
-MeasureSinglePatch 82 X;MeasureSinglePatch 83 Z;MeasureSinglePatch 81 Z;RequestYState 84 7;BellPairInit 85 86 7:Z,84:X [BellPrepare (5,8),(5,9);BellPrepare (6,9),(7,9)];
-BellPairInit 85 86 7:Z,84:X [BellMeasure (5,9),(6,9);Move (7,9),(8,9)];
+MeasureSinglePatch 82 X;MeasureSinglePatch 83 Z;MeasureSinglePatch 81 Z;RequestYState 84 7;BellPairInit 85 86 7:Z,84:X [BellPrepare (5,8),(5,9);BellPrepare (5,10),(5,11);BellPrepare (6,11),(7,11)];
+BellPairInit 85 86 7:Z,84:X [BellMeasure (5,9),(5,10);BellMeasure (5,11),(6,11);Move (7,11),(8,11)];
 MultiBodyMeasure 7:Z,85:Z;MultiBodyMeasure 86:X,84:X;
 MeasureSinglePatch 85 X;MeasureSinglePatch 86 Z;HGate 84;RotateSingleCellPatch 84;
 BusyRegion (4,8),(4,9),StepsToClear(1);
-BusyRegion (4,8),(4,9),StepsToClear(0);BellPairInit 87 88 7:Z,84:X [BellPrepare (5,8),(5,7);BellPrepare (6,7),(7,7);BellPrepare (7,8),(7,9)];
-BellPairInit 87 88 7:Z,84:X [BellMeasure (5,7),(6,7);BellMeasure (7,7),(7,8);Move (7,9),(8,9)];
+BusyRegion (4,8),(4,9),StepsToClear(0);BellPairInit 87 88 7:Z,84:X [BellPrepare (5,8),(5,9);BellPrepare (6,9),(7,9)];
+BellPairInit 87 88 7:Z,84:X [BellMeasure (5,9),(6,9);Move (7,9),(8,9)];
 MultiBodyMeasure 7:Z,87:Z;MultiBodyMeasure 88:X,84:X;
 MeasureSinglePatch 87 X;MeasureSinglePatch 88 Z;HGate 84;RotateSingleCellPatch 84;
 BusyRegion (4,8),(4,9),StepsToClear(1);
-BusyRegion (4,8),(4,9),StepsToClear(0);RequestYState 84 7;RequestMagicState 89;BellPairInit 90 91 8:Z,89:X [BellPrepare (13,16),(13,15);BellPrepare (12,15),(11,15);BellPrepare (11,14),(11,13);BellPrepare (10,13),(9,13)];
-BellPairInit 90 91 8:Z,89:X [BellMeasure (13,15),(12,15);BellMeasure (11,15),(11,14);BellMeasure (11,13),(10,13);Move (9,13),(8,13)];
+BusyRegion (4,8),(4,9),StepsToClear(0);RequestYState 84 7;RequestMagicState 89;BellPairInit 90 91 8:Z,89:X [BellPrepare (13,16),(13,15);BellPrepare (12,15),(11,15);BellPrepare (10,15),(9,15);BellPrepare (9,14),(9,13)];
+BellPairInit 90 91 8:Z,89:X [BellMeasure (13,15),(12,15);BellMeasure (11,15),(10,15);BellMeasure (9,15),(9,14);Move (9,13),(8,13)];
 MultiBodyMeasure 8:Z,90:Z;MultiBodyMeasure 91:X,89:X;
 MeasureSinglePatch 90 X;MeasureSinglePatch 91 Z;MeasureSinglePatch 89 Z;RequestYState 92 8;BellPairInit 93 94 8:Z,92:X [BellPrepare (5,12),(5,11);BellPrepare (6,11),(7,11)];
 BellPairInit 93 94 8:Z,92:X [BellMeasure (5,11),(6,11);Move (7,11),(8,11)];
 MultiBodyMeasure 8:Z,93:Z;MultiBodyMeasure 94:X,92:X;
 MeasureSinglePatch 93 X;MeasureSinglePatch 94 Z;HGate 92;RotateSingleCellPatch 92;
 BusyRegion (4,12),(4,13),StepsToClear(1);
-BusyRegion (4,12),(4,13),StepsToClear(0);BellPairInit 95 96 8:Z,92:X [BellPrepare (5,12),(5,13);BellPrepare (6,13),(7,13)];
-BellPairInit 95 96 8:Z,92:X [BellMeasure (5,13),(6,13);Move (7,13),(8,13)];
+BusyRegion (4,12),(4,13),StepsToClear(0);BellPairInit 95 96 8:Z,92:X [BellPrepare (5,12),(5,11);BellPrepare (6,11),(7,11)];
+BellPairInit 95 96 8:Z,92:X [BellMeasure (5,11),(6,11);Move (7,11),(8,11)];
 MultiBodyMeasure 8:Z,95:Z;MultiBodyMeasure 96:X,92:X;
 MeasureSinglePatch 95 X;MeasureSinglePatch 96 Z;HGate 92;RotateSingleCellPatch 92;
 BusyRegion (4,12),(4,13),StepsToClear(1);
-BusyRegion (4,12),(4,13),StepsToClear(0);RequestYState 92 8;RequestMagicState 97;BellPairInit 98 99 9:Z,97:X [BellPrepare (15,6),(15,7);BellPrepare (14,7),(13,7);BellPrepare (13,8),(13,9);BellPrepare (13,10),(13,11);BellPrepare (13,12),(13,13);BellPrepare (13,14),(13,15);BellPrepare (12,15),(11,15);BellPrepare (10,15),(9,15)];
-BellPairInit 98 99 9:Z,97:X [BellMeasure (15,7),(14,7);BellMeasure (13,7),(13,8);BellMeasure (13,9),(13,10);BellMeasure (13,11),(13,12);BellMeasure (13,13),(13,14);BellMeasure (13,15),(12,15);BellMeasure (11,15),(10,15);Move (9,15),(8,15)];
+BusyRegion (4,12),(4,13),StepsToClear(0);RequestYState 92 8;RequestMagicState 97;BellPairInit 98 99 9:Z,97:X [BellPrepare (15,6),(15,7);BellPrepare (14,7),(13,7);BellPrepare (12,7),(11,7);BellPrepare (10,7),(9,7);BellPrepare (9,8),(9,9);BellPrepare (9,10),(9,11);BellPrepare (9,12),(9,13)];
+BellPairInit 98 99 9:Z,97:X [BellMeasure (15,7),(14,7);BellMeasure (13,7),(12,7);BellMeasure (11,7),(10,7);BellMeasure (9,7),(9,8);BellMeasure (9,9),(9,10);BellMeasure (9,11),(9,12);Move (9,13),(8,13)];
 MultiBodyMeasure 9:Z,98:Z;MultiBodyMeasure 99:X,97:X;
-MeasureSinglePatch 98 X;MeasureSinglePatch 99 Z;MeasureSinglePatch 97 Z;RequestYState 100 9;BellPairInit 101 102 9:Z,100:X [BellPrepare (7,16),(7,15);BellPrepare (7,14),(7,13)];
-BellPairInit 101 102 9:Z,100:X [BellMeasure (7,15),(7,14);Move (7,13),(8,13)];
+MeasureSinglePatch 98 X;MeasureSinglePatch 99 Z;MeasureSinglePatch 97 Z;RequestYState 100 9;BellPairInit 101 102 9:Z,100:X [BellPrepare (7,16),(7,15)];
+BellPairInit 101 102 9:Z,100:X [Move (7,15),(8,15)];
 MultiBodyMeasure 9:Z,101:Z;MultiBodyMeasure 102:X,100:X;
 MeasureSinglePatch 101 X;MeasureSinglePatch 102 Z;HGate 100;RotateSingleCellPatch 100;
-BusyRegion (8,16),(8,15),StepsToClear(1);
-BusyRegion (8,16),(8,15),StepsToClear(0);BellPairInit 103 104 9:Z,100:X [BellPrepare (9,16),(9,15)];
-BellPairInit 103 104 9:Z,100:X [Move (9,15),(8,15)];
+BusyRegion (8,16),(9,16),StepsToClear(1);
+BusyRegion (8,16),(9,16),StepsToClear(0);BellPairInit 103 104 9:Z,100:X [BellPrepare (7,16),(7,15)];
+BellPairInit 103 104 9:Z,100:X [Move (7,15),(8,15)];
 MultiBodyMeasure 9:Z,103:Z;MultiBodyMeasure 104:X,100:X;
 MeasureSinglePatch 103 X;MeasureSinglePatch 104 Z;HGate 100;RotateSingleCellPatch 100;
-BusyRegion (8,16),(7,16),StepsToClear(1);
-BusyRegion (8,16),(7,16),StepsToClear(0);RequestYState 100 9;RequestMagicState 105;BellPairInit 106 107 10:Z,105:X [BellPrepare (15,10),(15,11);BellPrepare (14,11),(13,11);BellPrepare (13,10),(13,9);BellPrepare (13,8),(13,7);BellPrepare (12,7),(11,7)];
-BellPairInit 106 107 10:Z,105:X [BellMeasure (15,11),(14,11);BellMeasure (13,11),(13,10);BellMeasure (13,9),(13,8);BellMeasure (13,7),(12,7);Move (11,7),(10,7)];
+BusyRegion (8,16),(9,16),StepsToClear(1);
+BusyRegion (8,16),(9,16),StepsToClear(0);RequestYState 100 9;RequestMagicState 105;BellPairInit 106 107 10:Z,105:X [BellPrepare (15,10),(15,9);BellPrepare (14,9),(13,9);BellPrepare (12,9),(11,9);BellPrepare (11,8),(11,7)];
+BellPairInit 106 107 10:Z,105:X [BellMeasure (15,9),(14,9);BellMeasure (13,9),(12,9);BellMeasure (11,9),(11,8);Move (11,7),(10,7)];
 MultiBodyMeasure 10:Z,106:Z;MultiBodyMeasure 107:X,105:X;
 MeasureSinglePatch 106 X;MeasureSinglePatch 107 Z;MeasureSinglePatch 105 Z;RequestYState 108 10;BellPairInit 109 110 10:Z,108:X [BellPrepare (9,4),(9,5)];
 BellPairInit 109 110 10:Z,108:X [Move (9,5),(10,5)];
@@ -152,50 +152,50 @@ BellPairInit 111 112 10:Z,108:X [Move (9,5),(10,5)];
 MultiBodyMeasure 10:Z,111:Z;MultiBodyMeasure 112:X,108:X;
 MeasureSinglePatch 111 X;MeasureSinglePatch 112 Z;HGate 108;RotateSingleCellPatch 108;
 BusyRegion (8,4),(8,5),StepsToClear(1);
-BusyRegion (8,4),(8,5),StepsToClear(0);RequestYState 108 10;RequestMagicState 113;BellPairInit 114 115 11:Z,113:X [BellPrepare (15,14),(15,15);BellPrepare (14,15),(13,15);BellPrepare (13,14),(13,13);BellPrepare (13,12),(13,11);BellPrepare (13,10),(13,9);BellPrepare (12,9),(11,9)];
-BellPairInit 114 115 11:Z,113:X [BellMeasure (15,15),(14,15);BellMeasure (13,15),(13,14);BellMeasure (13,13),(13,12);BellMeasure (13,11),(13,10);BellMeasure (13,9),(12,9);Move (11,9),(10,9)];
+BusyRegion (8,4),(8,5),StepsToClear(0);RequestYState 108 10;RequestMagicState 113;BellPairInit 114 115 11:Z,113:X [BellPrepare (15,14),(15,13);BellPrepare (14,13),(13,13);BellPrepare (12,13),(11,13);BellPrepare (11,12),(11,11);BellPrepare (11,10),(11,9)];
+BellPairInit 114 115 11:Z,113:X [BellMeasure (15,13),(14,13);BellMeasure (13,13),(12,13);BellMeasure (11,13),(11,12);BellMeasure (11,11),(11,10);Move (11,9),(10,9)];
 MultiBodyMeasure 11:Z,114:Z;MultiBodyMeasure 115:X,113:X;
-MeasureSinglePatch 114 X;MeasureSinglePatch 115 Z;MeasureSinglePatch 113 Z;RequestYState 116 11;BellPairInit 117 118 11:Z,116:X [BellPrepare (5,8),(5,9);BellPrepare (5,10),(5,11);BellPrepare (6,11),(7,11);BellPrepare (8,11),(9,11);BellPrepare (9,10),(9,9);BellPrepare (9,8),(9,7)];
-BellPairInit 117 118 11:Z,116:X [BellMeasure (5,9),(5,10);BellMeasure (5,11),(6,11);BellMeasure (7,11),(8,11);BellMeasure (9,11),(9,10);BellMeasure (9,9),(9,8);Move (9,7),(10,7)];
+MeasureSinglePatch 114 X;MeasureSinglePatch 115 Z;MeasureSinglePatch 113 Z;RequestYState 116 11;BellPairInit 117 118 11:Z,116:X [BellPrepare (5,8),(5,7);BellPrepare (6,7),(7,7);BellPrepare (8,7),(9,7)];
+BellPairInit 117 118 11:Z,116:X [BellMeasure (5,7),(6,7);BellMeasure (7,7),(8,7);Move (9,7),(10,7)];
 MultiBodyMeasure 11:Z,117:Z;MultiBodyMeasure 118:X,116:X;
 MeasureSinglePatch 117 X;MeasureSinglePatch 118 Z;HGate 116;RotateSingleCellPatch 116;
 BusyRegion (4,8),(4,9),StepsToClear(1);
-BusyRegion (4,8),(4,9),StepsToClear(0);BellPairInit 119 120 11:Z,116:X [BellPrepare (5,8),(5,9);BellPrepare (6,9),(7,9);BellPrepare (8,9),(9,9)];
-BellPairInit 119 120 11:Z,116:X [BellMeasure (5,9),(6,9);BellMeasure (7,9),(8,9);Move (9,9),(10,9)];
+BusyRegion (4,8),(4,9),StepsToClear(0);BellPairInit 119 120 11:Z,116:X [BellPrepare (5,8),(5,7);BellPrepare (6,7),(7,7);BellPrepare (8,7),(9,7)];
+BellPairInit 119 120 11:Z,116:X [BellMeasure (5,7),(6,7);BellMeasure (7,7),(8,7);Move (9,7),(10,7)];
 MultiBodyMeasure 11:Z,119:Z;MultiBodyMeasure 120:X,116:X;
 MeasureSinglePatch 119 X;MeasureSinglePatch 120 Z;HGate 116;RotateSingleCellPatch 116;
 BusyRegion (4,8),(4,9),StepsToClear(1);
-BusyRegion (4,8),(4,9),StepsToClear(0);RequestYState 116 11;RequestMagicState 121;BellPairInit 122 123 12:Z,121:X [BellPrepare (5,6),(5,7);BellPrepare (5,8),(5,9);BellPrepare (5,10),(5,11);BellPrepare (6,11),(7,11);BellPrepare (8,11),(9,11)];
-BellPairInit 122 123 12:Z,121:X [BellMeasure (5,7),(5,8);BellMeasure (5,9),(5,10);BellMeasure (5,11),(6,11);BellMeasure (7,11),(8,11);Move (9,11),(10,11)];
+BusyRegion (4,8),(4,9),StepsToClear(0);RequestYState 116 11;RequestMagicState 121;BellPairInit 122 123 12:Z,121:X [BellPrepare (5,6),(5,7);BellPrepare (5,8),(5,9);BellPrepare (6,9),(7,9);BellPrepare (8,9),(9,9)];
+BellPairInit 122 123 12:Z,121:X [BellMeasure (5,7),(5,8);BellMeasure (5,9),(6,9);BellMeasure (7,9),(8,9);Move (9,9),(10,9)];
 MultiBodyMeasure 12:Z,122:Z;MultiBodyMeasure 123:X,121:X;
-MeasureSinglePatch 122 X;MeasureSinglePatch 123 Z;MeasureSinglePatch 121 Z;RequestYState 124 12;BellPairInit 125 126 12:Z,124:X [BellPrepare (5,8),(5,9);BellPrepare (5,10),(5,11);BellPrepare (6,11),(7,11);BellPrepare (8,11),(9,11);BellPrepare (9,10),(9,9)];
-BellPairInit 125 126 12:Z,124:X [BellMeasure (5,9),(5,10);BellMeasure (5,11),(6,11);BellMeasure (7,11),(8,11);BellMeasure (9,11),(9,10);Move (9,9),(10,9)];
+MeasureSinglePatch 122 X;MeasureSinglePatch 123 Z;MeasureSinglePatch 121 Z;RequestYState 124 12;BellPairInit 125 126 12:Z,124:X [BellPrepare (5,8),(5,9);BellPrepare (5,10),(5,11);BellPrepare (6,11),(7,11);BellPrepare (8,11),(9,11)];
+BellPairInit 125 126 12:Z,124:X [BellMeasure (5,9),(5,10);BellMeasure (5,11),(6,11);BellMeasure (7,11),(8,11);Move (9,11),(10,11)];
 MultiBodyMeasure 12:Z,125:Z;MultiBodyMeasure 126:X,124:X;
 MeasureSinglePatch 125 X;MeasureSinglePatch 126 Z;HGate 124;RotateSingleCellPatch 124;
 BusyRegion (4,8),(4,9),StepsToClear(1);
-BusyRegion (4,8),(4,9),StepsToClear(0);BellPairInit 127 128 12:Z,124:X [BellPrepare (5,8),(5,9);BellPrepare (5,10),(5,11);BellPrepare (6,11),(7,11);BellPrepare (8,11),(9,11)];
-BellPairInit 127 128 12:Z,124:X [BellMeasure (5,9),(5,10);BellMeasure (5,11),(6,11);BellMeasure (7,11),(8,11);Move (9,11),(10,11)];
+BusyRegion (4,8),(4,9),StepsToClear(0);BellPairInit 127 128 12:Z,124:X [BellPrepare (5,8),(5,9);BellPrepare (6,9),(7,9);BellPrepare (8,9),(9,9)];
+BellPairInit 127 128 12:Z,124:X [BellMeasure (5,9),(6,9);BellMeasure (7,9),(8,9);Move (9,9),(10,9)];
 MultiBodyMeasure 12:Z,127:Z;MultiBodyMeasure 128:X,124:X;
 MeasureSinglePatch 127 X;MeasureSinglePatch 128 Z;HGate 124;RotateSingleCellPatch 124;
 BusyRegion (4,8),(4,9),StepsToClear(1);
-BusyRegion (4,8),(4,9),StepsToClear(0);RequestYState 124 12;RequestMagicState 129;BellPairInit 130 131 13:Z,129:X [BellPrepare (5,10),(5,11);BellPrepare (5,12),(5,13);BellPrepare (6,13),(7,13);BellPrepare (8,13),(9,13)];
-BellPairInit 130 131 13:Z,129:X [BellMeasure (5,11),(5,12);BellMeasure (5,13),(6,13);BellMeasure (7,13),(8,13);Move (9,13),(10,13)];
+BusyRegion (4,8),(4,9),StepsToClear(0);RequestYState 124 12;RequestMagicState 129;BellPairInit 130 131 13:Z,129:X [BellPrepare (5,10),(5,11);BellPrepare (6,11),(7,11);BellPrepare (8,11),(9,11)];
+BellPairInit 130 131 13:Z,129:X [BellMeasure (5,11),(6,11);BellMeasure (7,11),(8,11);Move (9,11),(10,11)];
 MultiBodyMeasure 13:Z,130:Z;MultiBodyMeasure 131:X,129:X;
-MeasureSinglePatch 130 X;MeasureSinglePatch 131 Z;MeasureSinglePatch 129 Z;RequestYState 132 13;BellPairInit 133 134 13:Z,132:X [BellPrepare (5,12),(5,11);BellPrepare (6,11),(7,11);BellPrepare (8,11),(9,11)];
-BellPairInit 133 134 13:Z,132:X [BellMeasure (5,11),(6,11);BellMeasure (7,11),(8,11);Move (9,11),(10,11)];
+MeasureSinglePatch 130 X;MeasureSinglePatch 131 Z;MeasureSinglePatch 129 Z;RequestYState 132 13;BellPairInit 133 134 13:Z,132:X [BellPrepare (5,12),(5,13);BellPrepare (6,13),(7,13);BellPrepare (8,13),(9,13)];
+BellPairInit 133 134 13:Z,132:X [BellMeasure (5,13),(6,13);BellMeasure (7,13),(8,13);Move (9,13),(10,13)];
 MultiBodyMeasure 13:Z,133:Z;MultiBodyMeasure 134:X,132:X;
 MeasureSinglePatch 133 X;MeasureSinglePatch 134 Z;HGate 132;RotateSingleCellPatch 132;
 BusyRegion (4,12),(4,13),StepsToClear(1);
-BusyRegion (4,12),(4,13),StepsToClear(0);BellPairInit 135 136 13:Z,132:X [BellPrepare (5,12),(5,13);BellPrepare (6,13),(7,13);BellPrepare (8,13),(9,13)];
-BellPairInit 135 136 13:Z,132:X [BellMeasure (5,13),(6,13);BellMeasure (7,13),(8,13);Move (9,13),(10,13)];
+BusyRegion (4,12),(4,13),StepsToClear(0);BellPairInit 135 136 13:Z,132:X [BellPrepare (5,12),(5,11);BellPrepare (6,11),(7,11);BellPrepare (8,11),(9,11)];
+BellPairInit 135 136 13:Z,132:X [BellMeasure (5,11),(6,11);BellMeasure (7,11),(8,11);Move (9,11),(10,11)];
 MultiBodyMeasure 13:Z,135:Z;MultiBodyMeasure 136:X,132:X;
 MeasureSinglePatch 135 X;MeasureSinglePatch 136 Z;HGate 132;RotateSingleCellPatch 132;
 BusyRegion (4,12),(4,13),StepsToClear(1);
-BusyRegion (4,12),(4,13),StepsToClear(0);RequestYState 132 13;RequestMagicState 137;BellPairInit 138 139 14:Z,137:X [BellPrepare (5,14),(5,15);BellPrepare (6,15),(7,15);BellPrepare (8,15),(9,15)];
-BellPairInit 138 139 14:Z,137:X [BellMeasure (5,15),(6,15);BellMeasure (7,15),(8,15);Move (9,15),(10,15)];
+BusyRegion (4,12),(4,13),StepsToClear(0);RequestYState 132 13;RequestMagicState 137;BellPairInit 138 139 14:Z,137:X [BellPrepare (5,14),(5,13);BellPrepare (6,13),(7,13);BellPrepare (8,13),(9,13)];
+BellPairInit 138 139 14:Z,137:X [BellMeasure (5,13),(6,13);BellMeasure (7,13),(8,13);Move (9,13),(10,13)];
 MultiBodyMeasure 14:Z,138:Z;MultiBodyMeasure 139:X,137:X;
-MeasureSinglePatch 138 X;MeasureSinglePatch 139 Z;MeasureSinglePatch 137 Z;RequestYState 140 14;BellPairInit 141 142 14:Z,140:X [BellPrepare (9,16),(9,15);BellPrepare (9,14),(9,13)];
-BellPairInit 141 142 14:Z,140:X [BellMeasure (9,15),(9,14);Move (9,13),(10,13)];
+MeasureSinglePatch 138 X;MeasureSinglePatch 139 Z;MeasureSinglePatch 137 Z;RequestYState 140 14;BellPairInit 141 142 14:Z,140:X [BellPrepare (9,16),(9,15)];
+BellPairInit 141 142 14:Z,140:X [Move (9,15),(10,15)];
 MultiBodyMeasure 14:Z,141:Z;MultiBodyMeasure 142:X,140:X;
 MeasureSinglePatch 141 X;MeasureSinglePatch 142 Z;HGate 140;RotateSingleCellPatch 140;
 BusyRegion (8,16),(8,15),StepsToClear(1);
@@ -204,15 +204,15 @@ BellPairInit 143 144 14:Z,140:X [Move (9,15),(10,15)];
 MultiBodyMeasure 14:Z,143:Z;MultiBodyMeasure 144:X,140:X;
 MeasureSinglePatch 143 X;MeasureSinglePatch 144 Z;HGate 140;RotateSingleCellPatch 140;
 BusyRegion (8,16),(8,15),StepsToClear(1);
-BusyRegion (8,16),(8,15),StepsToClear(0);RequestYState 140 14;RequestMagicState 145;BellPairInit 146 147 15:Z,145:X [BellPrepare (7,4),(7,5);BellPrepare (7,6),(7,7);BellPrepare (8,7),(9,7);BellPrepare (10,7),(11,7)];
-BellPairInit 146 147 15:Z,145:X [BellMeasure (7,5),(7,6);BellMeasure (7,7),(8,7);BellMeasure (9,7),(10,7);Move (11,7),(12,7)];
+BusyRegion (8,16),(8,15),StepsToClear(0);RequestYState 140 14;RequestMagicState 145;BellPairInit 146 147 15:Z,145:X [BellPrepare (7,4),(7,5);BellPrepare (8,5),(9,5);BellPrepare (10,5),(11,5)];
+BellPairInit 146 147 15:Z,145:X [BellMeasure (7,5),(8,5);BellMeasure (9,5),(10,5);Move (11,5),(12,5)];
 MultiBodyMeasure 15:Z,146:Z;MultiBodyMeasure 147:X,145:X;
-MeasureSinglePatch 146 X;MeasureSinglePatch 147 Z;MeasureSinglePatch 145 Z;RequestYState 148 15;BellPairInit 149 150 15:Z,148:X [BellPrepare (11,4),(11,5)];
-BellPairInit 149 150 15:Z,148:X [Move (11,5),(12,5)];
+MeasureSinglePatch 146 X;MeasureSinglePatch 147 Z;MeasureSinglePatch 145 Z;RequestYState 148 15;BellPairInit 149 150 15:Z,148:X [BellPrepare (11,4),(11,5);BellPrepare (11,6),(11,7)];
+BellPairInit 149 150 15:Z,148:X [BellMeasure (11,5),(11,6);Move (11,7),(12,7)];
 MultiBodyMeasure 15:Z,149:Z;MultiBodyMeasure 150:X,148:X;
 MeasureSinglePatch 149 X;MeasureSinglePatch 150 Z;HGate 148;RotateSingleCellPatch 148;
-BusyRegion (12,4),(13,4),StepsToClear(1);
-BusyRegion (12,4),(13,4),StepsToClear(0);BellPairInit 151 152 15:Z,148:X [BellPrepare (11,4),(11,5)];
+BusyRegion (12,4),(12,5),StepsToClear(1);
+BusyRegion (12,4),(12,5),StepsToClear(0);BellPairInit 151 152 15:Z,148:X [BellPrepare (11,4),(11,5)];
 BellPairInit 151 152 15:Z,148:X [Move (11,5),(12,5)];
 MultiBodyMeasure 15:Z,151:Z;MultiBodyMeasure 152:X,148:X;
 MeasureSinglePatch 151 X;MeasureSinglePatch 152 Z;HGate 148;RotateSingleCellPatch 148;
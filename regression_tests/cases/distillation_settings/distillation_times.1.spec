@@ -2894,7 +2894,6 @@
          "patch_type": "Qubit",
          "text": "Id: 0"
       },
-      null,
       {
          "activity": {
             "activity_type": null
@@ -2908,6 +2907,19 @@
          "patch_type": "Ancilla",
          "text": ""
       },
+      {
+         "activity": {
+            "activity_type": null
+         },
+         "edges": {
+            "Bottom": "None",
+            "Left": "AncillaJoin",
+            "Right": "AncillaJoin",
+            "Top": "None"
+         },
+         "patch_type": "Ancilla",
+         "text": ""
+      },
       {
          "activity": {
             "activity_type": null
@@ -2996,19 +3008,6 @@
          "edges": {
             "Bottom": "AncillaJoin",
             "Left": "None",
-            "Right": "AncillaJoin",
-            "Top": "None"
-         },
-         "patch_type": "Ancilla",
-         "text": ""
-      },
-      {
-         "activity": {
-            "activity_type": null
-         },
-         "edges": {
-            "Bottom": "None",
-            "Left": "AncillaJoin",
             "Right": "None",
             "Top": "AncillaJoin"
          },
@@ -3016,6 +3015,7 @@
          "text": ""
       },
       null,
+      null,
       {
          "activity": {
             "activity_type": null
@@ -5476,7 +5476,6 @@
          "patch_type": "Qubit",
          "text": "Id: 0"
       },
-      null,
       {
          "activity": {
             "activity_type": null
@@ -5490,6 +5489,19 @@
          "patch_type": "Ancilla",
          "text": ""
       },
+      {
+         "activity": {
+            "activity_type": null
+         },
+         "edges": {
+            "Bottom": "None",
+            "Left": "AncillaJoin",
+            "Right": "AncillaJoin",
+            "Top": "None"
+         },
+         "patch_type": "Ancilla",
+         "text": ""
+      },
       {
          "activity": {
             "activity_type": null
@@ -5578,19 +5590,6 @@
          "edges": {
             "Bottom": "AncillaJoin",
             "Left": "None",
-            "Right": "AncillaJoin",
-            "Top": "None"
-         },
-         "patch_type": "Ancilla",
-         "text": ""
-      },
-      {
-         "activity": {
-            "activity_type": null
-         },
-         "edges": {
-            "Bottom": "None",
-            "Left": "AncillaJoin",
             "Right": "None",
             "Top": "AncillaJoin"
          },
@@ -5598,6 +5597,7 @@
          "text": ""
       },
       null,
+      null,
       {
          "activity": {
             "activity_type": null
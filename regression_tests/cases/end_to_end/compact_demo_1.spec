@@ -6038,6 +6038,19 @@
          "patch_type": "Ancilla",
          "text": ""
       },
+      {
+         "activity": {
+            "activity_type": null
+         },
+         "edges": {
+            "Bottom": "None",
+            "Left": "AncillaJoin",
+            "Right": "AncillaJoin",
+            "Top": "None"
+         },
+         "patch_type": "Ancilla",
+         "text": ""
+      },
       {
          "activity": {
             "activity_type": null
@@ -6053,7 +6066,6 @@
       },
       null,
       null,
-      null,
       {
          "activity": {
             "activity_type": null
@@ -6212,6 +6224,7 @@
          "patch_type": "Qubit",
          "text": "Id: 14"
       },
+      null,
       {
          "activity": {
             "activity_type": null
@@ -6225,19 +6238,6 @@
          "patch_type": "Ancilla",
          "text": ""
       },
-      {
-         "activity": {
-            "activity_type": null
-         },
-         "edges": {
-            "Bottom": "None",
-            "Left": "AncillaJoin",
-            "Right": "AncillaJoin",
-            "Top": "None"
-         },
-         "patch_type": "Ancilla",
-         "text": ""
-      },
       {
          "activity": {
             "activity_type": null
@@ -0,0 +1,50 @@
+djikstra:
+LS Instructions read  27
+Slices 11
+Made patch computation. Took <time_removed_by_case_script>
+Total volume: 1008
+Distillation volume: 315 (31.25%)
+Unused routing volume: 265 (26.2897%)
+Dead volume: 0 (0%)
+Other active volume: 428 (42.4603%)
+Negative route cache: 0 hits, 0 failures remembered, 0 invalidations
+astar:
+LS Instructions read  27
+Slices 11
+Made patch computation. Took <time_removed_by_case_script>
+Total volume: 1008
+Distillation volume: 315 (31.25%)
+Unused routing volume: 265 (26.2897%)
+Dead volume: 0 (0%)
+Other active volume: 428 (42.4603%)
+Negative route cache: 0 hits, 0 failures remembered, 0 invalidations
+bucket:
+LS Instructions read  27
+Slices 11
+Made patch computation. Took <time_removed_by_case_script>
+Total volume: 1008
+Distillation volume: 315 (31.25%)
+Unused routing volume: 265 (26.2897%)
+Dead volume: 0 (0%)
+Other active volume: 428 (42.4603%)
+Negative route cache: 0 hits, 0 failures remembered, 0 invalidations
+bitboard:
+LS Instructions read  27
+Slices 11
+Made patch computation. Took <time_removed_by_case_script>
+Total volume: 1008
+Distillation volume: 315 (31.25%)
+Unused routing volume: 265 (26.2897%)
+Dead volume: 0 (0%)
+Other active volume: 428 (42.4603%)
+Negative route cache: 0 hits, 0 failures remembered, 0 invalidations
+landmarks:
+LS Instructions read  27
+Slices 11
+Made patch computation. Took <time_removed_by_case_script>
+Total volume: 1008
+Distillation volume: 315 (31.25%)
+Unused routing volume: 265 (26.2897%)
+Dead volume: 0 (0%)
+Other active volume: 428 (42.4603%)
+Negative route cache: 0 hits, 0 failures remembered, 0 invalidations
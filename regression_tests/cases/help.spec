@@ -8,11 +8,17 @@ Options:
     -t, --timeout          Set a timeout in seconds after which stop producing slices
     -r, --router           Set a router: graph_search (default), graph_search_cached
     -P, --pipeline         pipeline mode: stream (default), dag
-    -g, --graph-search     Set a graph search provider: djikstra (default), astar, boost (not always available)
+    --dag-window           Requires -P dag. Keep at most this many instructions in the dag, reading more as they are applied (default: the whole circuit)
+    --scheduler            Requires -P dag. Order in which ready instructions are tried: label_order (default, circuit order), critical_path (longest chains of dependants first)
+    --threads              Number of threads (default 1). With 2 or more, reading and generating instructions runs on a thread of its own and slices are formatted as JSON on the other threads (at least one), while slicing stays on one thread
+    -g, --graph-search     Set a graph search provider: djikstra (default), astar, bucket (A* with integer costs), bitboard (BFS on bitboards), landmarks (A* with precomputed layout distances), boost and boost_incremental (not always available)
     --graceful             If there is an error when slicing, print the error and terminate
     --printlli             Output LLI instead of JSONs. options: before (default), sliced (prints lli on the same slice separated by semicolons)
     --printdag             Prints a dependancy dag of the circuit. Modes: input (default), processedlli
     --noslices             Do the slicing but don't write the slices out
+    --compact-json         Write the JSON of each slice on a single line, without indentation
+    --slice-format         Format of the slices: json (default), binary, binary_delta (binary with the changes from the previous slice). Convert binary to json with lsqecc_slices_to_json
+    --keyframe-interval    Requires a binary --slice-format. Make every this many slices a keyframe, where reading can start (default 128, 0 for only the first)
     --cnotcorrections      Add Xs and Zs to correct the the negative outcomes: never (default), always
     --layoutgenerator, -L  Automatically generates a layout for the given number of qubits. Incompatible with -l. Options:
                             - compact (default): Uses Litinski's Game of Surace Code compact layout (https://arxiv.org/abs/1808.02892)
@@ -0,0 +1,27 @@
+INPUT="
+DeclareLogicalQubitPatches 0,1,2,3
+MultiBodyMeasure 0:Z,1:X
+LogicalPauli 1 X
+HGate 2
+MultiBodyMeasure 2:Z,3:Z
+MeasureSinglePatch 0 Z
+"
+# Binary slices convert back to the same JSON, with and without delta encoding
+echo "$INPUT" | lsqecc_slicer -L compact > slices.json
+echo "$INPUT" | lsqecc_slicer -L compact --slice-format binary > slices.bin
+lsqecc_slices_to_json -i slices.bin > converted.json
+cmp slices.json converted.json && echo "Same JSON from binary"
+echo "$INPUT" | lsqecc_slicer -L compact --slice-format binary_delta > slices.bin
+lsqecc_slices_to_json < slices.bin > converted.json
+cmp slices.json converted.json && echo "Same JSON from binary_delta"
+# Converting from a slice in the middle starts from the keyframe before it
+echo "$INPUT" | lsqecc_slicer -L compact --slice-format binary_delta --keyframe-interval 2 > slices.bin
+lsqecc_slices_to_json -i slices.bin > converted.json
+cmp slices.json converted.json && echo "Same JSON from binary_delta with keyframes"
+lsqecc_slices_to_json -i slices.bin --first-slice 3 --num-slices 2 > from_keyframes.json
+echo "$INPUT" | lsqecc_slicer -L compact --slice-format binary --keyframe-interval 0 > slices.bin
+lsqecc_slices_to_json -i slices.bin --first-slice 3 --num-slices 2 > converted.json
+cmp from_keyframes.json converted.json && echo "Same slices 3 and 4 with and without keyframes"
+# Opening brackets of the array and of its two slices
+grep -c "^\[$" converted.json
+rm slices.json slices.bin converted.json from_keyframes.json
@@ -0,0 +1,5 @@
+Same JSON from binary
+Same JSON from binary_delta
+Same JSON from binary_delta with keyframes
+Same slices 3 and 4 with and without keyframes
+3
@@ -0,0 +1,10 @@
+INPUT="
+DeclareLogicalQubitPatches 0,1
+MeasureSinglePatch 0 Z
+"
+# Compact JSON writes each slice on a line of its own, the same with serialization workers
+echo "$INPUT" | lsqecc_slicer -L compact --compact-json > compact.json
+echo "$INPUT" | lsqecc_slicer -L compact --compact-json --threads 4 > compact_threaded.json
+cmp compact.json compact_threaded.json && echo "Same output with --threads 4"
+wc -l < compact.json
+rm compact.json compact_threaded.json
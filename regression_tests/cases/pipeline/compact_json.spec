@@ -0,0 +1,2 @@
+Same output with --threads 4
+2
@@ -0,0 +1,18 @@
+INPUT="
+DeclareLogicalQubitPatches 0,1,2,3
+MultiBodyMeasure 0:Z,1:X
+LogicalPauli 1 X
+HGate 2
+MultiBodyMeasure 2:Z,3:Z
+MeasureSinglePatch 0 Z
+"
+# Parsing and slice serialization on their own threads give the same slices, also with several serialization workers
+echo "$INPUT" | lsqecc_slicer -L compact > single_threaded.json
+echo "$INPUT" | lsqecc_slicer -L compact --threads 3 > threaded.json
+cmp single_threaded.json threaded.json && echo "Same output with --threads 3"
+echo "$INPUT" | lsqecc_slicer -L compact --threads 5 > threaded.json
+cmp single_threaded.json threaded.json && echo "Same output with --threads 5"
+echo "$INPUT" | lsqecc_slicer -L compact -P dag --threads 2 > threaded.json
+echo "$INPUT" | lsqecc_slicer -L compact -P dag > single_threaded.json
+cmp single_threaded.json threaded.json && echo "Same output with -P dag --threads 2"
+rm single_threaded.json threaded.json
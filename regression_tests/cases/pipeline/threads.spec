@@ -0,0 +1,3 @@
+Same output with --threads 3
+Same output with --threads 5
+Same output with -P dag --threads 2
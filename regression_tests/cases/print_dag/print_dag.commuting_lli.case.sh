@@ -0,0 +1,11 @@
+# Measurements that agree on the Pauli basis of every patch they share don't depend on each other. The Z correction
+# depends on both X measurements of patch 3
+INPUT="
+DeclareLogicalQubitPatches 0,1,2,3
+MultiBodyMeasure 0:Z,1:Z
+MultiBodyMeasure 0:Z,2:Z
+MultiBodyMeasure 1:X,3:X
+MultiBodyMeasure 0:Z,3:X
+LogicalPauli 3 Z
+"
+echo "$INPUT" | lsqecc_slicer --printdag input
@@ -0,0 +1,10 @@
+digraph DirectedGraph {
+  0 [shape="plaintext",label=<<table cellborder="0"><tr><td><b>MultiBodyMeasure 0:Z,1:Z</b></td></tr><tr><td><font color="darkgray">node: 0</font></td></tr></table>>];
+  1 [shape="plaintext",label=<<table cellborder="0"><tr><td><b>MultiBodyMeasure 0:Z,2:Z</b></td></tr><tr><td><font color="darkgray">node: 1</font></td></tr></table>>];
+  2 [shape="plaintext",label=<<table cellborder="0"><tr><td><b>MultiBodyMeasure 1:X,3:X</b></td></tr><tr><td><font color="darkgray">node: 2</font></td></tr></table>>];
+  3 [shape="plaintext",label=<<table cellborder="0"><tr><td><b>MultiBodyMeasure 0:Z,3:X</b></td></tr><tr><td><font color="darkgray">node: 3</font></td></tr></table>>];
+  4 [shape="plaintext",label=<<table cellborder="0"><tr><td><b>ZGate 3</b></td></tr><tr><td><font color="darkgray">node: 4</font></td></tr></table>>];
+  0 -> 2;
+  2 -> 4;
+  3 -> 4;
+}
@@ -9,10 +9,8 @@ digraph DirectedGraph {
   7 [shape="plaintext",label=<<table cellborder="0"><tr><td><b>RotateSingleCellPatch 1</b></td></tr><tr><td><font color="darkgray">node: 7</font></td></tr></table>>];
   8 [shape="plaintext",label=<<table cellborder="0"><tr><td><b>MultiBodyMeasure 0:Z,100:Z</b></td></tr><tr><td><font color="darkgray">node: 8</font></td></tr></table>>];
   0 -> 4;
-  0 -> 8;
   1 -> 8;
   4 -> 8;
   5 -> 6;
-  5 -> 7;
   6 -> 7;
 }
@@ -5,7 +5,6 @@ digraph DirectedGraph {
   3 [shape="plaintext",label=<<table cellborder="0"><tr><td><b>MultiBodyMeasure 0:Z,4:Z</b></td></tr><tr><td><font color="darkgray">node: 3</font></td></tr></table>>];
   0 -> 1;
   0 -> 2;
-  0 -> 3;
   1 -> 3;
   2 -> 3;
 }
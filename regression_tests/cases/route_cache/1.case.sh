@@ -0,0 +1,14 @@
+INPUT="
+OPENQASM 2.0;
+include \"qelib1.inc\";
+
+qreg q[15];
+
+cx q[0],q[10];
+cx q[0],q[10];
+cx q[5],q[7];
+cx q[0],q[10];
+cx q[5],q[7];
+"
+echo "$INPUT" | lsqecc_slicer --noslices -q -L compact -r graph_search_cached -f stats | \
+  sed "s/Made patch computation. Took [0-9]*.[0-9e\-]*s./Made patch computation. Took <time_removed_by_case_script>/"
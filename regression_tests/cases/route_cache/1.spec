@@ -0,0 +1,10 @@
+LS Instructions read  22
+Slices 5
+Made patch computation. Took <time_removed_by_case_script>
+Total volume: 720
+Distillation volume: 225 (31.25%)
+Unused routing volume: 172 (23.8889%)
+Dead volume: 0 (0%)
+Other active volume: 323 (44.8611%)
+Route cache: 4 hits, 6 misses, 0 invalidations, 0 evictions
+Negative route cache: 0 hits, 0 failures remembered, 0 invalidations
@@ -0,0 +1,10 @@
+INPUT="
+DeclareLogicalQubitPatches 0,1,2
+MultiBodyMeasure 0:Z,1:Z
+HGate 2
+HGate 2
+HGate 2
+"
+# The wall keeps 0 and 1 apart, so the measurement can never be routed. It still hits the retry limit while the
+# HGates on patch 2 go ahead
+echo "$INPUT" | lsqecc_slicer -l <(printf "QrXrQ\nrrXrr\nQrXrr\n") -P dag --printlli sliced --graceful | grep -v "^$"
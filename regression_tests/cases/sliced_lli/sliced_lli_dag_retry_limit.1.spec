@@ -0,0 +1,8 @@
+HGate 2;
+HGate 2;
+HGate 2;
+Encountered exception: Could not apply non-proximate instruction after 100 retries in slices where nothing could be applied:
+MultiBodyMeasure 0:Z,1:Z
+Caused by:
+MultiBodyMeasure 0:Z,1:Z; Couldn't find room to route
+Halting slicing
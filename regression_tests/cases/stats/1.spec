@@ -6,3 +6,4 @@ Distillation volume: 15 (31.25%)
 Unused routing volume: 18 (37.5%)
 Dead volume: 0 (0%)
 Other active volume: 15 (31.25%)
+Negative route cache: 0 hits, 0 failures remembered, 0 invalidations
@@ -6,3 +6,4 @@ Distillation volume: 315 (31.25%)
 Unused routing volume: 265 (26.2897%)
 Dead volume: 0 (0%)
 Other active volume: 428 (42.4603%)
+Negative route cache: 0 hits, 0 failures remembered, 0 invalidations
@@ -6,3 +6,4 @@ Distillation volume: 156 (35.3741%)
 Unused routing volume: 120 (27.2109%)
 Dead volume: 128 (29.0249%)
 Other active volume: 37 (8.39002%)
+Negative route cache: 0 hits, 0 failures remembered, 0 invalidations
@@ -0,0 +1,17 @@
+INPUT="
+DeclareLogicalQubitPatches 0,1,2,3,4,5,6
+HGate 5
+MultiBodyMeasure 6:X,5:X
+MultiBodyMeasure 5:X,3:Z
+MultiBodyMeasure 5:X,3:X
+MultiBodyMeasure 1:Z,5:X
+RotateSingleCellPatch 0
+MultiBodyMeasure 4:Z,1:X
+MultiBodyMeasure 4:X,1:Z
+MultiBodyMeasure 4:X,6:Z
+HGate 6
+MultiBodyMeasure 0:X,3:Z
+"
+# The stats compare the critical path schedule against label order
+echo "$INPUT" | lsqecc_slicer -l ../examples/core4by4layout.txt -P dag --scheduler critical_path -f stats --noslices | \
+  sed "s/Made patch computation. Took [0-9]*.[0-9e\-]*s./Made patch computation. Took <time_removed_by_case_script>/"
@@ -0,0 +1,10 @@
+LS Instructions read  13
+Slices 7
+Made patch computation. Took <time_removed_by_case_script>
+Total volume: 420
+Distillation volume: 216 (51.4286%)
+Unused routing volume: 118 (28.0952%)
+Dead volume: 0 (0%)
+Other active volume: 86 (20.4762%)
+Dag scheduler: critical_path, 7 slices against 10 with label_order
+Negative route cache: 0 hits, 1 failures remembered, 1 invalidations
@@ -0,0 +1,331 @@
+#include <lsqecc/dag/dense_directed_graph.hpp>
+#include <lstk/lstk.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+
+namespace lsqecc::dag {
+
+
+DenseDirectedGraph::Adjacency::Adjacency(const Adjacency& other)
+    : size_(other.size_), capacity_(other.is_inline() ? inline_capacity : std::max(other.size_, inline_capacity+1))
+{
+    if(!is_inline())
+        heap_ = new StoredLabel[capacity_];
+    std::copy(other.begin(), other.end(), data());
+}
+
+DenseDirectedGraph::Adjacency::Adjacency(Adjacency&& other) noexcept
+    : size_(other.size_), capacity_(other.capacity_)
+{
+    if(is_inline())
+        inline_ = other.inline_;
+    else
+        heap_ = other.heap_;
+    other.size_ = 0;
+    other.capacity_ = inline_capacity;
+}
+
+DenseDirectedGraph::Adjacency& DenseDirectedGraph::Adjacency::operator=(Adjacency other) noexcept
+{
+    this->~Adjacency();
+    new (this) Adjacency(std::move(other));
+    return *this;
+}
+
+DenseDirectedGraph::Adjacency::~Adjacency()
+{
+    if(!is_inline())
+        delete[] heap_;
+}
+
+bool DenseDirectedGraph::Adjacency::contains(StoredLabel label) const
+{
+    return std::find(begin(), end(), label) != end();
+}
+
+void DenseDirectedGraph::Adjacency::insert(StoredLabel label)
+{
+    if(size_ == capacity_)
+    {
+        if(capacity_ > std::numeric_limits<uint32_t>::max()/2)
+            throw std::length_error("Too many neighbours for a node of DenseDirectedGraph");
+        const uint32_t new_capacity = capacity_*2;
+        auto* new_data = new StoredLabel[new_capacity];
+        std::copy(begin(), end(), new_data);
+        if(!is_inline())
+            delete[] heap_;
+        heap_ = new_data;
+        capacity_ = new_capacity;
+    }
+    data()[size_++] = label;
+}
+
+void DenseDirectedGraph::Adjacency::erase(StoredLabel label)
+{
+    StoredLabel* first = data();
+    StoredLabel* last = first + size_;
+    StoredLabel* it = std::find(first, last, label);
+    if(it == last) return;
+    std::copy(it+1, last, it);
+    size_--;
+}
+
+void DenseDirectedGraph::Adjacency::clear()
+{
+    if(!is_inline())
+        delete[] heap_;
+    size_ = 0;
+    capacity_ = inline_capacity;
+}
+
+
+DenseDirectedGraph::Node& DenseDirectedGraph::node_at(label_t label, const char* what)
+{
+    return const_cast<Node&>(std::as_const(*this).node_at(label, what));
+}
+
+const DenseDirectedGraph::Node& DenseDirectedGraph::node_at(label_t label, const char* what) const
+{
+    if(!contains(label))
+        throw std::runtime_error(std::string{what} + std::to_string(label));
+    return nodes_[label - first_label_];
+}
+
+std::vector<label_t> DenseDirectedGraph::labels_of(const Adjacency& adjacency) const
+{
+    std::vector<label_t> labels;
+    labels.reserve(adjacency.size());
+    for(StoredLabel stored : adjacency)
+        labels.push_back(load(stored));
+    return labels;
+}
+
+void DenseDirectedGraph::trim()
+{
+    while(!nodes_.empty() && !nodes_.front().present)
+    {
+        nodes_.pop_front();
+        first_label_++;
+    }
+    if(nodes_.empty())
+        first_label_ = 0;
+}
+
+
+void DenseDirectedGraph::add_node(label_t label)
+{
+    if(nodes_.empty())
+        first_label_ = label;
+    else if(label < first_label_)
+    {
+        // Only happens for labels out of order, which just make the deque longer
+        nodes_.insert(nodes_.begin(), first_label_ - label, Node{});
+        first_label_ = label;
+    }
+
+    if(label - first_label_ >= std::numeric_limits<StoredLabel>::max())
+        throw std::length_error("Labels of a DenseDirectedGraph must all be within 2^32 of each other");
+    if(label - first_label_ >= nodes_.size())
+        nodes_.resize(label - first_label_ + 1);
+
+    Node& node = nodes_[label - first_label_];
+    if(!node.present)
+    {
+        node.present = true;
+        num_nodes_++;
+    }
+}
+
+void DenseDirectedGraph::add_edge(label_t from, label_t to)
+{
+    add_node(to);
+    add_node(from);
+    Node& from_node = nodes_[from - first_label_];
+    Node& to_node = nodes_[to - first_label_];
+
+    // Check the shorter list, nodes can have many predecessors
+    const bool exists = from_node.successors.size() <= to_node.predecessors.size()
+            ? from_node.successors.contains(store(to))
+            : to_node.predecessors.contains(store(from));
+    if(exists) return;
+
+    from_node.successors.insert(store(to));
+    to_node.predecessors.insert(store(from));
+}
+
+void DenseDirectedGraph::remove_edge(label_t from, label_t to)
+{
+    Node& from_node = node_at(from, "Cannot remove edge from non-existing node: ");
+    Node& to_node = node_at(to, "Cannot remove edge to non-existing node: ");
+    from_node.successors.erase(store(to));
+    to_node.predecessors.erase(store(from));
+}
+
+void DenseDirectedGraph::remove_node(label_t target)
+{
+    Node& node = node_at(target, "Cannot remove non-existing node: ");
+
+    for(StoredLabel to : node.successors)
+        nodes_[load(to) - first_label_].predecessors.erase(store(target));
+    for(StoredLabel from : node.predecessors)
+        nodes_[load(from) - first_label_].successors.erase(store(target));
+
+    node.successors.clear();
+    node.predecessors.clear();
+    node.present = false;
+    num_nodes_--;
+    trim();
+}
+
+bool DenseDirectedGraph::contains(label_t label) const
+{
+    return label >= first_label_ && label - first_label_ < nodes_.size() && nodes_[label - first_label_].present;
+}
+
+
+std::vector<label_t> DenseDirectedGraph::successors(label_t label) const
+{
+    return labels_of(node_at(label, "Cannot get successors of non-existing node: ").successors);
+}
+
+std::vector<label_t> DenseDirectedGraph::predecessors(label_t label) const
+{
+    return labels_of(node_at(label, "Cannot get predecessors of non-existing node: ").predecessors);
+}
+
+size_t DenseDirectedGraph::in_degree(label_t label) const
+{
+    return node_at(label, "Cannot get the in degree of non-existing node: ").predecessors.size();
+}
+
+
+void DenseDirectedGraph::expand(label_t target, const std::vector<label_t>& replacement)
+{
+    if(!contains(target))
+        throw std::runtime_error("Cannot expand non-existing node: " + std::to_string(target));
+
+    if(replacement.size() < 1)
+        throw std::runtime_error("Cannot expand into less than 1 node");
+
+    for(const auto& label : replacement)
+    {
+        if(contains(label))
+            throw std::runtime_error("Cannot expand into existing node");
+    }
+
+    add_node(replacement.front());
+
+    for(std::size_t i = 1; i < replacement.size(); ++i)
+        add_edge(replacement.at(i-1), replacement.at((i)));
+
+    // The target's edges move to the ends of the replacement
+    const std::vector<label_t> forward_dangling = successors(target);
+    const std::vector<label_t> backward_dangling = predecessors(target);
+
+    remove_node(target);
+    for(const auto& to : forward_dangling)
+        add_edge(replacement.back(), to);
+    for(const auto& from : backward_dangling)
+        add_edge(from, replacement.front());
+}
+
+
+std::vector<label_t> DenseDirectedGraph::heads() const
+{
+    std::vector<label_t> heads;
+    for(size_t i = 0; i < nodes_.size(); i++)
+        if(nodes_[i].present && nodes_[i].predecessors.size() == 0)
+            heads.push_back(first_label_ + i);
+    return heads;
+}
+
+std::vector<label_t> DenseDirectedGraph::tails() const
+{
+    std::vector<label_t> tails;
+    for(size_t i = 0; i < nodes_.size(); i++)
+        if(nodes_[i].present && nodes_[i].successors.size() == 0)
+            tails.push_back(first_label_ + i);
+    return tails;
+}
+
+
+std::vector<label_t> DenseDirectedGraph::topological_order_tails_first() const
+{
+    // Same order as DirectedGraph's recursive depth first search, with an explicit stack as these graphs can be deep
+    std::vector<label_t> order;
+    std::vector<bool> visited(nodes_.size(), false);
+    std::vector<std::pair<label_t, uint32_t>> stack; // Node and index of the next successor to visit
+
+    for(label_t head : heads())
+    {
+        if(visited[head - first_label_]) continue;
+        visited[head - first_label_] = true;
+        stack.emplace_back(head, 0);
+
+        while(!stack.empty())
+        {
+            auto& [current, next_successor] = stack.back();
+            const Adjacency& successors = nodes_[current - first_label_].successors;
+            if(next_successor < successors.size())
+            {
+                const label_t successor = load(successors.begin()[next_successor++]);
+                if(!visited[successor - first_label_])
+                {
+                    visited[successor - first_label_] = true;
+                    stack.emplace_back(successor, 0);
+                }
+            }
+            else
+            {
+                order.push_back(current);
+                stack.pop_back();
+            }
+        }
+    }
+    return order;
+}
+
+
+std::ostream& DenseDirectedGraph::to_graphviz(
+    std::ostream& os,
+    const Map<label_t,std::string>& nodes_contents,
+    std::optional<std::stringstream>&& extra_content
+) const
+{
+    os << "digraph DirectedGraph {" << std::endl;
+
+    for(size_t i = 0; i < nodes_.size(); i++)
+    {
+        if(!nodes_[i].present) continue;
+        const label_t label = first_label_ + i;
+        if(nodes_contents.contains(label))
+            os << "  "<<label << " [shape=\"plaintext\","
+               << "label=<"
+               << "<table cellborder=\"0\">"
+               <<   "<tr><td><b>" << lstk::str_replace(nodes_contents.at(label),'>',"&gt;") << "</b></td></tr>"
+               <<   "<tr><td><font color=\"darkgray\">node: " << label << "</font></td></tr>"
+               << "</table>"
+            << ">];" << std::endl;
+        else
+            os << "  " << label << ";" << std::endl;
+    }
+
+    for(size_t i = 0; i < nodes_.size(); i++)
+        for(StoredLabel to : nodes_[i].successors)
+            os << "  " << first_label_ + i << " -> " << load(to) << ";" << std::endl;
+
+    if(extra_content)
+        os << extra_content->str();
+
+    os << "}" << std::endl;
+    return os;
+}
+
+
+} // namespace lsqecc::dag
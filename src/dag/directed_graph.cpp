@@ -39,11 +39,12 @@ void DirectedGraph::remove_node(label_t target)
     if(!edges_.count(target))
         throw std::runtime_error("Cannot remove non-existing node: " + std::to_string(target));
 
+    // Only the other endpoints need updating, the node's own edge sets are dropped with it
     for(const auto& to : edges_.at(target))
-        remove_edge(target, to);
+        back_edges_.at(to).erase(target);
 
     for(const auto& from : back_edges_.at(target))
-        remove_edge(from, target);
+        edges_.at(from).erase(target);
 
     edges_.erase(target);
     back_edges_.erase(target);
@@ -73,6 +74,14 @@ std::vector<label_t> DirectedGraph::predecessors(label_t label) const
     return predecessors;
 }
 
+size_t DirectedGraph::in_degree(label_t label) const
+{
+    if(!back_edges_.count(label))
+        throw std::runtime_error("Cannot get the in degree of non-existing node: " + std::to_string(label));
+
+    return back_edges_.at(label).size();
+}
+
 void DirectedGraph::expand(label_t target, const std::vector<label_t>& replacement)
 {
     if(!edges_.count(target))
@@ -11,7 +11,7 @@ DependencyDag<LSInstruction> full_dependency_dag_from_instruction_stream(LSInstr
 {
     DependencyDag<LSInstruction> dag;
     while (instruction_stream.has_next_instruction())
-        dag.push_instruction_based_on_commutation(instruction_stream.get_next_instruction());
+        dag.push_instruction_based_on_local_commutation(instruction_stream.get_next_instruction());
 
     return dag;
 }
@@ -22,7 +22,7 @@ DependencyDag<gates::Gate> full_dependency_dag_from_gate_stream(GateStream& gate
 {
     DependencyDag<gates::Gate> dag;
     while (gate_stream.has_next_gate())
-        dag.push_instruction_based_on_commutation(gate_stream.get_next_gate());
+        dag.push_instruction_based_on_local_commutation(gate_stream.get_next_gate());
 
     return dag;
 }
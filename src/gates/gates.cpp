@@ -139,9 +139,9 @@ std::optional<CNOTAncillaPlacement> CNOTAncillaPlacement_fromString(std::string_
 }
 
 
-tsl::ordered_set<QubitNum> get_operating_qubits(const Gate& gate)
+OperatingQubits operating_qubits(const Gate& gate)
 {
-    tsl::ordered_set<QubitNum> res;
+    OperatingQubits res;
 
     std::visit(lstk::overloaded{
         [&](const BasicSingleQubitGate& g){
@@ -172,6 +172,12 @@ tsl::ordered_set<QubitNum> get_operating_qubits(const Gate& gate)
     return res;
 }
 
+tsl::ordered_set<QubitNum> get_operating_qubits(const Gate& gate)
+{
+    const OperatingQubits qubits = operating_qubits(gate);
+    return {qubits.begin(), qubits.end()};
+}
+
 } // namespace lsqecc::gates
 
 namespace lsqecc {
@@ -210,6 +210,9 @@ void LayoutFromSpec::init_cache(const AsciiLayoutSpec& spec, const DistillationO
     cached_ancilla_locations_ = spec.find_all_cells_of_type(AsciiLayoutSpec::CellType::AncillaQubitLocation);
     cached_dead_cells_ = spec.find_all_cells_of_type(AsciiLayoutSpec::CellType::DeadCell);
     cached_y_states_ = spec.find_all_cells_of_type(AsciiLayoutSpec::CellType::PreDistilledYState);
+
+    // Needs everything above
+    cached_static_distances_.emplace(*this);
 }
 
 
@@ -0,0 +1,236 @@
+#include <lsqecc/layout/graph_search/bitboard_graph_search.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <lstk/lstk.hpp>
+
+
+namespace lsqecc {
+
+
+namespace bitboard_graph_search {
+
+
+using Word = CellBitboard::Word;
+
+
+struct CellList
+{
+    std::array<Cell,4> cells;
+    size_t size = 0;
+
+    void push_back(const Cell& c) {cells[size++] = c;}
+    const Cell* begin() const {return cells.data();}
+    const Cell* end() const {return cells.data()+size;}
+};
+
+
+// Same order as Cell::get_neigbours_within_bounding_box_inclusive
+CellList neighbours_within(const Cell& cell, const CellBitboard& board)
+{
+    CellList ret;
+    if(cell.row > 0)                                   ret.push_back({cell.row-1, cell.col});
+    if(static_cast<size_t>(cell.row)+1 < board.rows()) ret.push_back({cell.row+1, cell.col});
+    if(cell.col > 0)                                   ret.push_back({cell.row, cell.col-1});
+    if(static_cast<size_t>(cell.col)+1 < board.cols()) ret.push_back({cell.row, cell.col+1});
+    return ret;
+}
+
+
+// Free cells next to a patch that a route can leave or enter it from, i.e. through a boundary matching op
+CellList free_neighbours_through_boundary(
+        const Slice& slice, const CellBitboard& free_cells, const Cell& patch_cell, PauliOperator op)
+{
+    CellList ret;
+    for(const Cell& neighbour : neighbours_within(patch_cell, free_cells))
+        if(free_cells.test(neighbour) && slice.have_boundary_of_type_with(patch_cell, neighbour, op))
+            ret.push_back(neighbour);
+    return ret;
+}
+
+
+/*
+ * Writes the free, unvisited neighbours of the frontier into next. Only the words around the frontier's non empty
+ * words are computed: each is combined with its horizontal shifts (carrying across word boundaries) and with the same
+ * word in the rows above and below. Expects next to be all zeros and appends its non empty words to next_words.
+ */
+void expand_frontier(
+        const CellBitboard& frontier,
+        const std::vector<size_t>& frontier_words,
+        const CellBitboard& free_cells,
+        const CellBitboard& visited,
+        CellBitboard& next,
+        std::vector<size_t>& next_words)
+{
+    const size_t words_per_row = frontier.words_per_row();
+    const size_t num_words = words_per_row*frontier.rows();
+    const Word* f = frontier.row(0);
+    const Word* free_words = free_cells.row(0);
+    const Word* visited_words = visited.row(0);
+    Word* n = next.row(0);
+
+    auto compute_word = [&](size_t i) {
+        if(n[i]) return; // Already computed from another frontier word
+        const size_t w = i % words_per_row;
+
+        Word reached = (f[i] << 1) | (f[i] >> 1);
+        if(w > 0) reached |= f[i-1] >> (CellBitboard::bits_per_word-1);
+        if(w+1 < words_per_row) reached |= f[i+1] << (CellBitboard::bits_per_word-1);
+        if(i >= words_per_row) reached |= f[i-words_per_row];
+        if(i+words_per_row < num_words) reached |= f[i+words_per_row];
+
+        n[i] = reached & free_words[i] & ~visited_words[i];
+        if(n[i]) next_words.push_back(i);
+    };
+
+    for(size_t i : frontier_words)
+    {
+        const size_t w = i % words_per_row;
+        compute_word(i);
+        if(w > 0) compute_word(i-1);
+        if(w+1 < words_per_row) compute_word(i+1);
+        if(i >= words_per_row) compute_word(i-words_per_row);
+        if(i+words_per_row < num_words) compute_word(i+words_per_row);
+    }
+}
+
+
+std::optional<RoutingRegion> graph_search_route_ancilla(
+        const Slice& slice,
+        PatchId source,
+        PauliOperator source_op,
+        PatchId target,
+        PauliOperator target_op,
+        BitboardSearchWorkspace& workspace
+)
+{
+    const Cell source_cell = slice.get_cell_by_id(source).value();
+    const Cell target_cell = slice.get_cell_by_id(target).value();
+    const Cell furthest_cell = slice.get_layout().furthest_cell();
+    const auto rows = static_cast<size_t>(furthest_cell.row+1);
+    const auto cols = static_cast<size_t>(furthest_cell.col+1);
+
+    const CellBitboard* free_cells = slice.free_cell_bitboard();
+    if(!free_cells)
+    {
+        workspace.free_cells.reset(rows, cols);
+        for(Cell::CoordinateType row = 0; row <= furthest_cell.row; row++)
+            for(Cell::CoordinateType col = 0; col <= furthest_cell.col; col++)
+                if(slice.is_cell_free({row, col}))
+                    workspace.free_cells.set({row, col}, true);
+        free_cells = &workspace.free_cells;
+    }
+
+    // Neighbouring patches can be merged directly
+    if(source != target)
+    {
+        for(const Cell& neighbour : neighbours_within(source_cell, *free_cells))
+            if(neighbour == target_cell
+               && slice.have_boundary_of_type_with(source_cell, target_cell, source_op)
+               && slice.have_boundary_of_type_with(target_cell, source_cell, target_op))
+                return RoutingRegion{};
+    }
+
+    const CellList starts = free_neighbours_through_boundary(slice, *free_cells, source_cell, source_op);
+    const CellList goals = free_neighbours_through_boundary(slice, *free_cells, target_cell, target_op);
+    if(!starts.size || !goals.size) return std::nullopt;
+
+    workspace.frontier.reset(rows, cols);
+    workspace.next_frontier.reset(rows, cols);
+    workspace.visited.reset(rows, cols);
+    custom_graph_search::SearchWorkspace& layers = workspace.layers;
+    layers.reset(rows*cols);
+
+    auto make_vertex = [cols](const Cell& c) {return static_cast<size_t>(c.row)*cols + static_cast<size_t>(c.col);};
+
+    const size_t words_per_row = workspace.frontier.words_per_row();
+    workspace.frontier_words.clear();
+    workspace.next_frontier_words.clear();
+    for(const Cell& start : starts)
+    {
+        workspace.frontier.set(start, true);
+        workspace.visited.set(start, true);
+        layers.set(make_vertex(start), 1, make_vertex(start));
+        workspace.frontier_words.push_back(static_cast<size_t>(start.row)*words_per_row
+                                           + static_cast<size_t>(start.col)/CellBitboard::bits_per_word);
+    }
+    std::sort(workspace.frontier_words.begin(), workspace.frontier_words.end());
+    workspace.frontier_words.erase(
+            std::unique(workspace.frontier_words.begin(), workspace.frontier_words.end()),
+            workspace.frontier_words.end());
+
+    size_t layer = 1;
+    std::optional<Cell> reached_goal;
+    while(true)
+    {
+        for(const Cell& goal : goals)
+        {
+            if(layers.has_distance(make_vertex(goal)))
+            {
+                reached_goal = goal;
+                break;
+            }
+        }
+        if(reached_goal) break;
+
+        expand_frontier(workspace.frontier, workspace.frontier_words, *free_cells, workspace.visited,
+                        workspace.next_frontier, workspace.next_frontier_words);
+        if(workspace.next_frontier_words.empty()) return std::nullopt;
+        layer++;
+
+        Word* next_frontier = workspace.next_frontier.row(0);
+        Word* visited = workspace.visited.row(0);
+        for(size_t i : workspace.next_frontier_words)
+        {
+            visited[i] |= next_frontier[i];
+            const size_t first_vertex = (i / words_per_row)*cols + (i % words_per_row)*CellBitboard::bits_per_word;
+            for(Word bits = next_frontier[i]; bits; bits &= bits-1)
+            {
+                const size_t v = first_vertex + static_cast<size_t>(std::countr_zero(bits));
+                layers.set(v, layer, v);
+            }
+        }
+
+        // Leave the old frontier all zeros so that it can be reused as the next one
+        Word* frontier = workspace.frontier.row(0);
+        for(size_t i : workspace.frontier_words)
+            frontier[i] = 0;
+        workspace.frontier_words.clear();
+
+        std::swap(workspace.frontier, workspace.next_frontier);
+        std::swap(workspace.frontier_words, workspace.next_frontier_words);
+    }
+
+    // Walk back from the goal through strictly decreasing layers, ordered from the target to the source like the
+    // other graph searches
+    RoutingRegion ret;
+    Cell prec = target_cell;
+    Cell curr = *reached_goal;
+    for(size_t d = layer; d >= 1; d--)
+    {
+        Cell next = source_cell;
+        if(d > 1)
+        {
+            for(const Cell& neighbour : neighbours_within(curr, *free_cells))
+            {
+                const size_t v = make_vertex(neighbour);
+                if(layers.has_distance(v) && layers.distance(v) == d-1)
+                {
+                    next = neighbour;
+                    break;
+                }
+            }
+        }
+
+        ret.cells.push_back(LayoutHelpers::routing_cell_on_path(prec, curr, next));
+        prec = curr;
+        curr = next;
+    }
+
+    return ret;
+}
+
+
+}
+}
@@ -7,6 +7,9 @@
 # include <boost/graph/graphviz.hpp>
 #endif
 
+#include <lsqecc/patches/cell_bitboard.hpp>
+
+#include <bit>
 #include <iostream>
 
 namespace lsqecc {
@@ -61,7 +64,7 @@ std::optional<RoutingRegion> graph_search_route_ancilla(
         {
             Cell current{row_idx, col_idx};
             vertices.push_back(make_vertex(current));
-            if (!slice.is_cell_free(current))
+            if (slice.is_cell_free(current))
                 for (const Cell& neighbour: current.get_neigbours_within_bounding_box_inclusive({0, 0}, furthest_cell))
                     if (slice.is_cell_free(neighbour))
                         edges.emplace_back(make_vertex(neighbour), make_vertex(current));
@@ -92,7 +95,8 @@ std::optional<RoutingRegion> graph_search_route_ancilla(
             edges.emplace_back(make_vertex(neighbour), target_vertex);
     }
 
-    Graph g{edges.begin(), edges.end(), vertices.size()};
+    std::vector<int> weights(edges.size(), 1);
+    Graph g{edges.begin(), edges.end(), weights.begin(), vertices.size()};
 
     property_map<Graph, vertex_predecessor_t>::type p
             = get(vertex_predecessor, g);
@@ -129,34 +133,241 @@ std::optional<RoutingRegion> graph_search_route_ancilla(
         Cell curr_cell = cell_from_vertex(curr);
         Cell next_cell = cell_from_vertex(next);
 
-        ret.cells.push_back(SingleCellOccupiedByPatch{
-                {.top=   {BoundaryType::None, false},
-                 .bottom={BoundaryType::None, false},
-                 .left=  {BoundaryType::None, false},
-                 .right= {BoundaryType::None, false}},
-                curr_cell
-        });
+        ret.cells.push_back(LayoutHelpers::routing_cell_on_path(prec_cell, curr_cell, next_cell));
+
+        prec = curr;
+        curr = next;
+        next = p[next];
+    }
+
+    // Check if out path reached the source
+    return curr==s ? std::make_optional(ret) : std::nullopt;
+}
+
+
+namespace {
+
+using IncrementalBoostGraph = boost::adjacency_list<boost::vecS,
+                                                    boost::vecS,
+                                                    boost::directedS,
+                                                    boost::no_property,
+                                                    boost::property<boost::edge_weight_t, int>>;
+using IncrementalVertex = boost::graph_traits<IncrementalBoostGraph>::vertex_descriptor;
+
+// Thrown to stop Djikstra once the target's distance is final, the way Boost suggests for early exits
+struct FoundTarget {};
+
+struct StopAtTarget : public boost::default_dijkstra_visitor
+{
+    IncrementalVertex target;
+
+    explicit StopAtTarget(IncrementalVertex _target) : target(_target) {}
+
+    template<class G>
+    void examine_vertex(IncrementalVertex u, const G&) const
+    {
+        if(u == target) throw FoundTarget{};
+    }
+};
+
+}
+
+
+struct IncrementalGraph::Impl
+{
+    const Layout* layout = nullptr;
+    Cell furthest_cell{0, 0};
+    // Edges join each pair of neighbouring cells that are free here, in both directions. The extra vertex after the
+    // cells is the simulated target of S-gate/twist measurements
+    IncrementalBoostGraph graph;
+    CellBitboard free_cells;
+    CellBitboard scratch_free_cells; // For slices that don't keep a free cell bitboard
+    std::vector<IncrementalVertex> predecessors;
+    std::vector<int> distances;
+    std::vector<boost::default_color_type> colors;
+
+    size_t num_cells() const {return static_cast<size_t>((furthest_cell.row+1)*(furthest_cell.col+1));}
+
+    IncrementalVertex make_vertex(const Cell& cell) const
+    {
+        return static_cast<IncrementalVertex>(cell.row*(furthest_cell.col+1)+cell.col);
+    }
+
+    Cell cell_from_vertex(IncrementalVertex vertex) const
+    {
+        auto v = static_cast<Cell::CoordinateType>(vertex);
+        auto col = v%(furthest_cell.col+1);
+        return Cell{(v-col)/(furthest_cell.col+1), col};
+    }
+
+    void rebuild(const Layout& new_layout)
+    {
+        layout = &new_layout;
+        furthest_cell = new_layout.furthest_cell();
+        // Reset in place, copy assigning a fresh graph goes through adjacency_list::copy_impl for nothing
+        graph.clear();
+        for(size_t i = 0; i < num_cells()+1; i++)
+            boost::add_vertex(graph);
+        free_cells = CellBitboard{static_cast<size_t>(furthest_cell.row+1), static_cast<size_t>(furthest_cell.col+1)};
+        predecessors.resize(num_cells()+1);
+        distances.resize(num_cells()+1);
+        colors.resize(num_cells()+1);
+    }
+
+    void set_free(const Cell& cell, bool free)
+    {
+        const IncrementalVertex v = make_vertex(cell);
+        for(const Cell& neighbour : cell.get_neigbours_within_bounding_box_inclusive({0, 0}, furthest_cell))
+        {
+            if(!free_cells.test(neighbour)) continue;
+            const IncrementalVertex u = make_vertex(neighbour);
+            if(free)
+            {
+                boost::add_edge(u, v, 1, graph);
+                boost::add_edge(v, u, 1, graph);
+            }
+            else
+            {
+                boost::remove_edge(u, v, graph);
+                boost::remove_edge(v, u, graph);
+            }
+        }
+        free_cells.set(cell, free);
+    }
+
+    // Updates the edges of the cells whose occupancy changed since the last search
+    void sync(const Slice& slice)
+    {
+        if(layout != &slice.get_layout() || !(furthest_cell == slice.get_layout().furthest_cell()))
+            rebuild(slice.get_layout());
+
+        const CellBitboard* current = slice.free_cell_bitboard();
+        if(!current)
+        {
+            scratch_free_cells = CellBitboard{free_cells.rows(), free_cells.cols()};
+            slice.get_layout().for_each_cell([&](const Cell& cell){
+                if(slice.is_cell_free(cell)) scratch_free_cells.set(cell, true);
+            });
+            current = &scratch_free_cells;
+        }
 
-        for (const Cell& neighbour: curr_cell.get_neigbours_within_bounding_box_inclusive({0, 0}, furthest_cell))
+        const size_t words_per_row = free_cells.words_per_row();
+        for(size_t row = 0; row < free_cells.rows(); row++)
         {
-            if (prec_cell==neighbour || next_cell==neighbour)
+            for(size_t w = 0; w < words_per_row; w++)
             {
-                auto boundary = ret.cells.back().get_mut_boundary_with(neighbour);
-                if (boundary) boundary->get() = {.boundary_type=BoundaryType::Connected, .is_active=true};
+                for(CellBitboard::Word changed = free_cells.row(row)[w] ^ current->row(row)[w]; changed; changed &= changed-1)
+                {
+                    const Cell cell = Cell::from_ints(row, w*CellBitboard::bits_per_word + static_cast<size_t>(std::countr_zero(changed)));
+                    set_free(cell, current->test(cell));
+                }
             }
         }
+    }
+};
+
+IncrementalGraph::IncrementalGraph() : impl_(std::make_unique<Impl>()) {}
+IncrementalGraph::~IncrementalGraph() = default;
+
+size_t IncrementalGraph::num_edges() const
+{
+    return boost::num_edges(impl_->graph);
+}
+
+
+std::optional<RoutingRegion> graph_search_route_ancilla(
+        const Slice& slice,
+        PatchId source,
+        PauliOperator source_op,
+        PatchId target,
+        PauliOperator target_op,
+        IncrementalGraph& incremental_graph
+)
+{
+    IncrementalGraph::Impl& impl = *incremental_graph.impl_;
+    impl.sync(slice);
+    IncrementalBoostGraph& g = impl.graph;
+
+    const Cell source_cell = slice.get_cell_by_id(source).value();
+    const Cell target_cell = slice.get_cell_by_id(target).value();
+    const IncrementalVertex s = impl.make_vertex(source_cell);
+    // Same as above, a second copy of the source stands in for the target of S-gate/twist measurements
+    const IncrementalVertex target_vertex = source == target ? impl.num_cells() : impl.make_vertex(target_cell);
+
+    // Source and target edges only exist for this search
+    std::vector<std::pair<IncrementalVertex, IncrementalVertex>> search_edges;
+    for(const Cell& neighbour : slice.get_neigbours_within_slice(source_cell))
+    {
+        if(impl.free_cells.test(neighbour) && slice.have_boundary_of_type_with(source_cell, neighbour, source_op))
+            search_edges.emplace_back(s, impl.make_vertex(neighbour));
+        if(neighbour == target_cell && source != target
+           && slice.have_boundary_of_type_with(source_cell, target_cell, source_op)
+           && slice.have_boundary_of_type_with(target_cell, source_cell, target_op))
+            search_edges.emplace_back(s, target_vertex);
+    }
+    for(const Cell& neighbour : slice.get_neigbours_within_slice(target_cell))
+        if(impl.free_cells.test(neighbour) && slice.have_boundary_of_type_with(target_cell, neighbour, target_op))
+            search_edges.emplace_back(impl.make_vertex(neighbour), target_vertex);
+    for(const auto& [u, v] : search_edges)
+        boost::add_edge(u, v, 1, g);
+
+    const auto index = boost::get(boost::vertex_index, g);
+    auto p = boost::make_iterator_property_map(impl.predecessors.begin(), index);
+    try
+    {
+        boost::dijkstra_shortest_paths(g, s,
+                boost::predecessor_map(p)
+                .distance_map(boost::make_iterator_property_map(impl.distances.begin(), index))
+                .color_map(boost::make_iterator_property_map(impl.colors.begin(), index))
+                .visitor(StopAtTarget{target_vertex}));
+    }
+    catch(const FoundTarget&) {}
+
+    for(const auto& [u, v] : search_edges)
+        boost::remove_edge(u, v, g);
+
+    RoutingRegion ret;
+
+    IncrementalVertex prec = impl.make_vertex(target_cell);
+    IncrementalVertex curr = p[target_vertex];
+    IncrementalVertex next = p[curr];
+    while (curr!=next)
+    {
+        ret.cells.push_back(LayoutHelpers::routing_cell_on_path(
+                impl.cell_from_vertex(prec), impl.cell_from_vertex(curr), impl.cell_from_vertex(next)));
 
         prec = curr;
         curr = next;
         next = p[next];
     }
 
-    // Check if out path reached the source
     return curr==s ? std::make_optional(ret) : std::nullopt;
 }
 
 #else
 
+struct IncrementalGraph::Impl {};
+
+IncrementalGraph::IncrementalGraph() : impl_(std::make_unique<Impl>()) {}
+IncrementalGraph::~IncrementalGraph() = default;
+
+size_t IncrementalGraph::num_edges() const
+{
+    return 0;
+}
+
+std::optional<RoutingRegion> graph_search_route_ancilla(
+        const Slice& slice,
+        PatchId source,
+        PauliOperator source_op,
+        PatchId target,
+        PauliOperator target_op,
+        IncrementalGraph& graph
+)
+{
+    throw std::runtime_error("Boost graph search not available");
+}
+
 std::optional<RoutingRegion> graph_search_route_ancilla(
         const Slice& slice,
         PatchId source,
@@ -1,6 +1,9 @@
 #include <lsqecc/layout/graph_search/custom_graph_search.hpp>
+#include <lsqecc/layout/layout.hpp>
 
 #include <iostream>
+#include <algorithm>
+#include <array>
 #include <lstk/lstk.hpp>
 
 
@@ -11,19 +14,61 @@ namespace custom_graph_search {
 
 
 
-// Index in the data structure storing the list of vertices
-using Vertex = size_t;
-
-struct PredecessorData {
-    std::optional<size_t> distance;
-    Vertex predecessor;
+void SearchWorkspace::reset(size_t num_vertices)
+{
+    if(stamps_.size() < num_vertices)
+    {
+        stamps_.resize(num_vertices, 0);
+        distances_.resize(num_vertices);
+        predecessors_.resize(num_vertices);
+    }
+    frontier_.clear();
+    for(auto& bucket : buckets_)
+        bucket.clear();
+    lowest_bucket_ = 0;
+    bucket_entries_ = 0;
 
-    double cost() const
+    if(++generation_ == 0)
     {
-        return static_cast<double>(distance.value_or(std::numeric_limits<size_t>::max()));
+        // Wrapped around, old stamps could now look current
+        std::fill(stamps_.begin(), stamps_.end(), 0);
+        generation_ = 1;
     }
-};
+}
+
+void SearchWorkspace::push_frontier(double priority, Vertex v)
+{
+    frontier_.push_back({priority, v});
+    std::push_heap(frontier_.begin(), frontier_.end(), std::greater<>{});
+}
+
+SearchWorkspace::FrontierEntry SearchWorkspace::pop_frontier()
+{
+    std::pop_heap(frontier_.begin(), frontier_.end(), std::greater<>{});
+    FrontierEntry top = frontier_.back();
+    frontier_.pop_back();
+    return top;
+}
+
+
+void SearchWorkspace::push_bucket(size_t priority, Vertex v)
+{
+    if(priority >= buckets_.size())
+        buckets_.resize(priority+1);
+    buckets_[priority].push_back(v);
+    lowest_bucket_ = std::min(lowest_bucket_, priority);
+    bucket_entries_++;
+}
 
+SearchWorkspace::FrontierEntry SearchWorkspace::pop_bucket()
+{
+    while(buckets_[lowest_bucket_].empty())
+        lowest_bucket_++;
+    Vertex v = buckets_[lowest_bucket_].back();
+    buckets_[lowest_bucket_].pop_back();
+    bucket_entries_--;
+    return {static_cast<double>(lowest_bucket_), v};
+}
 
 
 double euclidean_distance(Cell a, Cell b)
@@ -31,29 +76,35 @@ double euclidean_distance(Cell a, Cell b)
     return std::sqrt(std::pow(a.row - b.row, 2) + std::pow(a.col - b.col, 2));
 }
 
-template <class SliceSearcher, Heuristic heuristic>
-struct Comparator
+template <Heuristic heuristic>
+constexpr bool has_integer_costs = heuristic == Heuristic::Manhattan || heuristic == Heuristic::Landmarks;
+
+using LandmarkHeuristic = std::optional<StaticDistances::TargetHeuristic>;
+
+template <Heuristic heuristic>
+double heuristic_cost(const Cell& cell, const Cell& target_cell, const LandmarkHeuristic& landmarks)
 {
-    bool operator()(const Vertex& a, const Vertex& b) const
-    {
-        if constexpr(heuristic == Heuristic::None)
-        {
-            return predecessor_map[a].cost() > predecessor_map[b].cost();
-        }
-        else if constexpr(heuristic == Heuristic::Euclidean)
-        {
-            return predecessor_map[a].cost() + euclidean_distance(slice_searcher.cell_from_vertex(a), target_cell) >
-                   predecessor_map[b].cost() + euclidean_distance(slice_searcher.cell_from_vertex(b), target_cell);
-        }
-        else
-        {
-            throw std::runtime_error(lstk::cat("Unknown heuristic: ", static_cast<int>(heuristic)));
-        }
-    }
+    if constexpr(heuristic == Heuristic::None)
+        return 0.0;
+    else if constexpr(heuristic == Heuristic::Euclidean)
+        return euclidean_distance(cell, target_cell);
+    else if constexpr(heuristic == Heuristic::Manhattan)
+        return std::abs(cell.row - target_cell.row) + std::abs(cell.col - target_cell.col);
+    else if constexpr(heuristic == Heuristic::Landmarks)
+        return landmarks ? (*landmarks)(cell) : std::abs(cell.row - target_cell.row) + std::abs(cell.col - target_cell.col);
+    else
+        throw std::runtime_error(lstk::cat("Unknown heuristic: ", static_cast<int>(heuristic)));
+}
+
+
+// At most 4 neighbours on the square lattice, kept inline so that expanding a vertex doesn't allocate
+struct NeighbourCells
+{
+    std::array<Cell,4> cells;
+    size_t size = 0;
 
-    Cell target_cell;
-    const std::vector<PredecessorData> predecessor_map;
-    const SliceSearcher& slice_searcher;
+    const Cell* begin() const {return cells.data();}
+    const Cell* end() const {return cells.data()+size;}
 };
 
 
@@ -145,14 +196,21 @@ public:
         return Cell{(v-col)/(furthest_cell().col+1), col};
     };
 
-    std::vector<Cell> get_neighbours(Vertex v) const
+    NeighbourCells get_neighbours(Vertex v) const
     {
         return get_neighbours(cell_from_vertex(v));
     }
 
-    std::vector<Cell> get_neighbours(Cell cell) const
+    // Same order as Cell::get_neigbours_within_bounding_box_inclusive
+    NeighbourCells get_neighbours(Cell cell) const
     {
-        return cell.get_neigbours_within_bounding_box_inclusive({0, 0}, furthest_cell());
+        const Cell furthest = furthest_cell();
+        NeighbourCells ret;
+        if(cell.row > 0)             ret.cells[ret.size++] = Cell{cell.row-1, cell.col};
+        if(cell.row < furthest.row)  ret.cells[ret.size++] = Cell{cell.row+1, cell.col};
+        if(cell.col > 0)             ret.cells[ret.size++] = Cell{cell.row, cell.col-1};
+        if(cell.col < furthest.col)  ret.cells[ret.size++] = Cell{cell.row, cell.col+1};
+        return ret;
     }
 
 private:
@@ -176,7 +234,8 @@ std::optional<RoutingRegion> do_graph_search_route_ancilla(
         PatchId source,
         PauliOperator source_op,
         PatchId target,
-        PauliOperator target_op
+        PauliOperator target_op,
+        SearchWorkspace& workspace
 )
 {
 
@@ -185,82 +244,91 @@ std::optional<RoutingRegion> do_graph_search_route_ancilla(
 
     const SliceSearchAdaptor<want_cycle> slice_searcher(slice, source_cell, target_cell, source_op, target_op);
 
+    // One extra vertex for the simulated source of the cycle case
+    workspace.reset(slice_searcher.num_vertices_on_lattice() + (want_cycle ? 1 : 0));
 
-    size_t num_vertices_on_lattice = slice_searcher.num_vertices_on_lattice();
-    std::vector<PredecessorData> predecessor_map(num_vertices_on_lattice);
-    for (size_t i = 0; i<predecessor_map.size(); ++i)
-        predecessor_map[i] = PredecessorData{std::nullopt, i};
+    LandmarkHeuristic landmarks;
+    if constexpr (heuristic == Heuristic::Landmarks)
+        if(const StaticDistances* static_distances = slice.get_layout().static_distances())
+            landmarks.emplace(static_distances->heuristic_to(target_cell));
 
-    Comparator<decltype(slice_searcher), heuristic> cmp{target_cell, predecessor_map, slice_searcher};
-    std::priority_queue<Vertex, std::vector<Vertex>, decltype(cmp)> frontier(cmp);
+    auto push = [&](Vertex v, size_t distance) {
+        const double priority = static_cast<double>(distance)
+                + heuristic_cost<heuristic>(slice_searcher.cell_from_vertex(v), target_cell, landmarks);
+        if constexpr (has_integer_costs<heuristic>)
+            workspace.push_bucket(static_cast<size_t>(priority), v);
+        else
+            workspace.push_frontier(priority, v);
+    };
+    auto pop = [&]() {
+        if constexpr (has_integer_costs<heuristic>)
+            return workspace.pop_bucket();
+        else
+            return workspace.pop_frontier();
+    };
+    auto frontier_empty = [&]() {
+        if constexpr (has_integer_costs<heuristic>)
+            return workspace.buckets_empty();
+        else
+            return workspace.frontier_empty();
+    };
 
     if constexpr (!want_cycle)
     {
-        predecessor_map[slice_searcher.source_vertex()] = {0, slice_searcher.source_vertex()};
-        frontier.push(slice_searcher.source_vertex());
+        workspace.set(slice_searcher.source_vertex(), 0, slice_searcher.source_vertex());
+        push(slice_searcher.source_vertex(), 0);
     }
     else // Simulated double source to force a cycle case
     {
         Vertex simulated_source = slice_searcher.simulated_source();
-        predecessor_map.push_back(PredecessorData{0,simulated_source});
+        workspace.set(simulated_source, 0, simulated_source);
 
-        auto neighbours = slice_searcher.get_neighbours(source_cell);
-        for(const Cell& neighbour_cell : neighbours)
+        for(const Cell& neighbour_cell : slice_searcher.get_neighbours(source_cell))
         {
             if(slice_searcher.have_directed_edge(source_cell, neighbour_cell))
             {
                 Vertex neighbour = slice_searcher.make_vertex(neighbour_cell);
-                predecessor_map[neighbour] = {1, simulated_source};
-                frontier.push(neighbour);
+                workspace.set(neighbour, 1, simulated_source);
+                push(neighbour, 1);
             }
         }
 
     }
 
-    while(frontier.size()>0)
+    while(!frontier_empty())
     {
-        Vertex curr = frontier.top(); frontier.pop();
-        size_t distance_to_curr = *predecessor_map[curr].distance;
+        const auto entry = pop();
+        const Vertex curr = entry.vertex;
+        const size_t distance_to_curr = workspace.distance(curr);
 
-        if constexpr (heuristic != Heuristic::None)
-            if(curr == slice_searcher.target_vertex()) break;
+        // Skip entries superseded by a shorter path found after they were pushed
+        if(entry.priority > static_cast<double>(distance_to_curr)
+                            + heuristic_cost<heuristic>(slice_searcher.cell_from_vertex(curr), target_cell, landmarks))
+            continue;
 
-        auto neighbours = slice_searcher.get_neighbours(curr);
-        for(const Cell& neighbour_cell : neighbours)
+        // Costs are non-negative and the heuristics are consistent, so the target's path is final once it is popped
+        if(curr == slice_searcher.target_vertex()) break;
+
+        const Cell curr_cell = slice_searcher.cell_from_vertex(curr);
+        for(const Cell& neighbour_cell : slice_searcher.get_neighbours(curr_cell))
         {
-            if(!slice_searcher.have_directed_edge(slice_searcher.cell_from_vertex(curr), neighbour_cell))
+            if(!slice_searcher.have_directed_edge(curr_cell, neighbour_cell))
                 continue;
 
             Vertex neighbour = slice_searcher.make_vertex(neighbour_cell);
-            if(!predecessor_map[neighbour].distance)
-            {
-                predecessor_map[neighbour] = {distance_to_curr+1, curr};
-                frontier.push(neighbour);
-            }
-            else
+            if(!workspace.has_distance(neighbour) || workspace.distance(neighbour) > distance_to_curr+1)
             {
-                if(*predecessor_map[neighbour].distance > distance_to_curr+1)
-                    predecessor_map[neighbour] = {distance_to_curr+1, curr};
+                workspace.set(neighbour, distance_to_curr+1, curr);
+                push(neighbour, distance_to_curr+1);
             }
         }
     }
 
-#if false
-
-    std::cout<< source_vertex << " to " << target_vertex<<std::endl;
-
-    for (size_t i = 0; i<predecessor_map.size(); ++i)
-        std::cout << i << "->" << predecessor_map[i].predecessor
-                  << " (" << (predecessor_map[i].distance ? std::to_string(*predecessor_map[i].distance) : "N/A") << ")" << std::endl;
-#endif
-
-
-    // TODO refactor this to be shared with the boost implementation
     RoutingRegion ret;
 
     Vertex prec = slice_searcher.target_vertex();
-    Vertex curr = predecessor_map[slice_searcher.target_vertex()].predecessor;
-    Vertex next = predecessor_map[curr].predecessor;
+    Vertex curr = workspace.predecessor(slice_searcher.target_vertex());
+    Vertex next = workspace.predecessor(curr);
 
     while (curr!=next)
     {
@@ -268,26 +336,11 @@ std::optional<RoutingRegion> do_graph_search_route_ancilla(
         Cell curr_cell = slice_searcher.cell_from_vertex(curr);
         Cell next_cell = slice_searcher.cell_from_vertex(next);
 
-        ret.cells.push_back(SingleCellOccupiedByPatch{
-                {.top=   {BoundaryType::None, false},
-                 .bottom={BoundaryType::None, false},
-                 .left=  {BoundaryType::None, false},
-                 .right= {BoundaryType::None, false}},
-                curr_cell
-        });
-
-        for (const Cell& neighbour: slice_searcher.get_neighbours(curr_cell))
-        {
-            if (prec_cell==neighbour || next_cell==neighbour)
-            {
-                auto boundary = ret.cells.back().get_mut_boundary_with(neighbour);
-                if (boundary) boundary->get() = {.boundary_type=BoundaryType::Connected, .is_active=true};
-            }
-        }
+        ret.cells.push_back(LayoutHelpers::routing_cell_on_path(prec_cell, curr_cell, next_cell));
 
         prec = curr;
         curr = next;
-        next = predecessor_map[next].predecessor;
+        next = workspace.predecessor(next);
     }
 
     // Check if out path reached the source
@@ -304,12 +357,13 @@ std::optional<RoutingRegion> graph_search_route_ancilla_dispatc_heuristic(
         PatchId source,
         PauliOperator source_op,
         PatchId target,
-        PauliOperator target_op
+        PauliOperator target_op,
+        SearchWorkspace& workspace
 )
 {
     return source == target ?
-        do_graph_search_route_ancilla<true, heuristic>(slice, source, source_op, target, target_op):
-        do_graph_search_route_ancilla<false, heuristic>(slice, source, source_op, target, target_op);
+        do_graph_search_route_ancilla<true, heuristic>(slice, source, source_op, target, target_op, workspace):
+        do_graph_search_route_ancilla<false, heuristic>(slice, source, source_op, target, target_op, workspace);
 }
 
 
@@ -319,13 +373,18 @@ std::optional<RoutingRegion> graph_search_route_ancilla(
         PauliOperator source_op,
         PatchId target,
         PauliOperator target_op,
-        Heuristic heuristic
+        Heuristic heuristic,
+        SearchWorkspace& workspace
 )
 {
     if(heuristic == Heuristic::None)
-        return graph_search_route_ancilla_dispatc_heuristic<Heuristic::None>(slice, source, source_op, target, target_op);
+        return graph_search_route_ancilla_dispatc_heuristic<Heuristic::None>(slice, source, source_op, target, target_op, workspace);
     else if(heuristic == Heuristic::Euclidean)
-        return graph_search_route_ancilla_dispatc_heuristic<Heuristic::Euclidean>(slice, source, source_op, target, target_op);
+        return graph_search_route_ancilla_dispatc_heuristic<Heuristic::Euclidean>(slice, source, source_op, target, target_op, workspace);
+    else if(heuristic == Heuristic::Manhattan)
+        return graph_search_route_ancilla_dispatc_heuristic<Heuristic::Manhattan>(slice, source, source_op, target, target_op, workspace);
+    else if(heuristic == Heuristic::Landmarks)
+        return graph_search_route_ancilla_dispatc_heuristic<Heuristic::Landmarks>(slice, source, source_op, target, target_op, workspace);
     else
         throw std::runtime_error(lstk::cat("Unknown heuristic: ", static_cast<int>(heuristic)));
 }
@@ -28,6 +28,22 @@ SingleCellOccupiedByPatch LayoutHelpers::make_distillation_region_cell(Cell plac
                 placement
         };
 }
+SingleCellOccupiedByPatch LayoutHelpers::routing_cell_on_path(Cell previous, Cell placement, Cell next)
+{
+    SingleCellOccupiedByPatch ret{
+            {.top=   {BoundaryType::None, false},
+             .bottom={BoundaryType::None, false},
+             .left=  {BoundaryType::None, false},
+             .right= {BoundaryType::None, false}},
+            placement};
+
+    for(const Cell& neighbour : {previous, next})
+    {
+        auto boundary = ret.get_mut_boundary_with(neighbour);
+        if (boundary) boundary->get() = {.boundary_type=BoundaryType::Connected, .is_active=true};
+    }
+    return ret;
+}
 LayoutHelpers::SinglePatchRotationALaLitinskiStages LayoutHelpers::single_patch_rotation_a_la_litinski(
         const SparsePatch& target_patch, const Cell& free_neighbour)
 {
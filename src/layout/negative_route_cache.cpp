@@ -0,0 +1,151 @@
+#include <lsqecc/layout/negative_route_cache.hpp>
+
+#include <algorithm>
+
+
+namespace lsqecc {
+
+
+RouteQuery RouteQuery::from_ids(const Slice& slice, PatchId source, PauliOperator source_op,
+                                PatchId target, PauliOperator target_op)
+{
+    Cell source_cell = slice.get_cell_by_id(source).value();
+    Cell target_cell = slice.get_cell_by_id(target).value();
+    return RouteQuery{source_cell, source_op, target_cell, target_op};
+}
+
+
+namespace {
+
+// splitmix64 finaliser, spreads nearby inputs over the whole range
+uint64_t mix_bits(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+uint64_t pack_cell_and_op(const Cell& cell, PauliOperator op)
+{
+    // 30 bits per coordinate leaves room for the operator in the top bits
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cell.row) & 0x3fffffff) << 30)
+           | (static_cast<uint64_t>(static_cast<uint32_t>(cell.col) & 0x3fffffff))
+           | (static_cast<uint64_t>(op) << 60);
+}
+
+}
+
+size_t RouteQuery::hash::operator()(const RouteQuery& x) const
+{
+    const uint64_t source_hash = mix_bits(pack_cell_and_op(x.source_cell, x.source_op));
+    return static_cast<size_t>(mix_bits(source_hash ^ (pack_cell_and_op(x.target_cell, x.target_op) + 0x9e3779b97f4a7c15ULL)));
+}
+
+
+bool NegativeRouteCache::known_to_fail(const Slice& slice, const RouteQuery& query)
+{
+    const RegionVersions* versions = slice.region_versions();
+    if(!versions) return false;
+    use_versions_of(*versions);
+
+    auto failure = failures_.find(query);
+    if(failure == failures_.end()) return false;
+
+    for(const auto& [tile, version] : failure->second)
+    {
+        if(versions->version(tile) != version)
+        {
+            stats_.invalidations++;
+            failures_.erase(failure);
+            return false;
+        }
+    }
+    stats_.hits++;
+    return true;
+}
+
+void NegativeRouteCache::remember_failure(const Slice& slice, const RouteQuery& query)
+{
+    const RegionVersions* versions = slice.region_versions();
+    if(!versions) return;
+    use_versions_of(*versions);
+
+    // Failures are cheap to recompute compared to tracking their age, so just start over when full
+    if(failures_.size() >= capacity_)
+        failures_.clear();
+
+    collect_footprint(slice, *versions, query, failures_[query]);
+    stats_.remembered++;
+}
+
+void NegativeRouteCache::use_versions_of(const RegionVersions& versions)
+{
+    if(versions_id_ == versions.id()) return;
+    failures_.clear();
+    versions_id_ = versions.id();
+}
+
+void NegativeRouteCache::collect_footprint(const Slice& slice, const RegionVersions& versions, const RouteQuery& query,
+                                           Footprint& footprint)
+{
+    const Cell furthest_cell = slice.get_layout().furthest_cell();
+    const size_t cols = static_cast<size_t>(furthest_cell.col+1);
+    const size_t num_cells = static_cast<size_t>(furthest_cell.row+1)*cols;
+    if(visited_.size() < num_cells) visited_.resize(num_cells, 0);
+    if(++generation_ == 0)
+    {
+        std::fill(visited_.begin(), visited_.end(), 0);
+        generation_ = 1;
+    }
+    tile_in_footprint_.assign(versions.num_tiles(), false);
+    footprint.clear();
+
+    auto add_tile_of = [&](const Cell& cell){
+        const size_t tile = versions.tile_of(cell);
+        if(tile_in_footprint_[tile]) return;
+        tile_in_footprint_[tile] = true;
+        footprint.emplace_back(tile, versions.version(tile));
+    };
+    auto visit = [&](const Cell& cell){
+        auto& stamp = visited_[static_cast<size_t>(cell.row)*cols + static_cast<size_t>(cell.col)];
+        if(stamp == generation_) return;
+        stamp = generation_;
+        queue_.push_back(cell);
+    };
+
+    // The source and target boundaries decide where routes can start and end
+    add_tile_of(query.source_cell);
+    add_tile_of(query.target_cell);
+
+    queue_.clear();
+    for(const Cell& neighbour : slice.get_neigbours_within_slice(query.source_cell))
+    {
+        add_tile_of(neighbour);
+        if(slice.is_cell_free(neighbour) && slice.have_boundary_of_type_with(query.source_cell, neighbour, query.source_op))
+            visit(neighbour);
+    }
+
+    // Every free cell a route could reach, and the occupied cells around them that it could not get through
+    for(size_t next = 0; next < queue_.size(); next++)
+    {
+        const Cell cell = queue_[next];
+        for(const Cell& neighbour : slice.get_neigbours_within_slice(cell))
+        {
+            add_tile_of(neighbour);
+            if(slice.is_cell_free(neighbour))
+                visit(neighbour);
+        }
+    }
+}
+
+
+std::ostream& operator<<(std::ostream& os, const NegativeRouteCache::Stats& stats)
+{
+    return os << "Negative route cache: " << stats.hits << " hits, " << stats.remembered << " failures remembered, "
+              << stats.invalidations << " invalidations";
+}
+
+}
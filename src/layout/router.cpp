@@ -7,63 +7,118 @@ namespace lsqecc {
 
 
 
-CachedRouter::PathIdentifier path_identifier_from_ids(
-        const Slice& slice,
-        PatchId source,
-        PauliOperator source_op,
-        PatchId target,
-        PauliOperator target_op)
+// Whether a cached route can still be used as is on this slice
+bool route_is_still_valid(const Slice& slice, const RouteQuery& path, const RoutingRegion& route)
 {
-    Cell source_cell = slice.get_cell_by_id(source).value();
-    Cell target_cell = slice.get_cell_by_id(target).value();
-    return CachedRouter::PathIdentifier{source_cell, source_op, target_cell, target_op};
+    for(const auto& occupied_cell : route.cells)
+        if(!slice.is_cell_free(occupied_cell.cell))
+            return false;
+
+    // Routes are ordered from the target to the source, see stitch_boundaries
+    const Cell source_neighbour = route.cells.empty() ? path.target_cell : route.cells.back().cell;
+    const Cell target_neighbour = route.cells.empty() ? path.source_cell : route.cells.front().cell;
+    return slice.have_boundary_of_type_with(path.source_cell, source_neighbour, path.source_op)
+           && slice.have_boundary_of_type_with(path.target_cell, target_neighbour, path.target_op);
+}
+
+CachedRouter::CachedRouter(size_t capacity)
+: capacity_(capacity)
+{
+    if(capacity_ == 0)
+        throw std::logic_error("CachedRouter needs room for at least one route");
 }
 
 std::optional<RoutingRegion> CachedRouter::find_routing_ancilla(const Slice& slice, PatchId source,
         PauliOperator source_op, PatchId target, PauliOperator target_op) const
 {
+    auto path_identifier = RouteQuery::from_ids(slice, source, source_op, target, target_op);
 
+    auto cached = cached_routes_.find(path_identifier);
+    if(cached != cached_routes_.end())
+    {
+        if(route_is_still_valid(slice, path_identifier, cached->second->second))
+        {
+            stats_.hits++;
+            lru_routes_.splice(lru_routes_.begin(), lru_routes_, cached->second);
+            return cached->second->second;
+        }
+        stats_.invalidations++;
+        lru_routes_.erase(cached->second);
+        cached_routes_.erase(cached);
+    }
+    else
+        stats_.misses++;
 
-    auto path_identifier = path_identifier_from_ids(slice, source, source_op, target, target_op);
-    if(!cached_routes_.contains(path_identifier))
+    auto route = router_impl_.find_routing_ancilla(
+            slice, source, source_op, target, target_op);
+    if(!route) return std::nullopt;
+
+    if(cached_routes_.size() >= capacity_)
     {
-        auto route = router_impl_.find_routing_ancilla(
-                slice, source, source_op, target, target_op);
-        if(!route) return std::nullopt;
-        cached_routes_.insert({path_identifier, *route});
+        stats_.evictions++;
+        cached_routes_.erase(lru_routes_.back().first);
+        lru_routes_.pop_back();
     }
+    lru_routes_.emplace_front(path_identifier, *route);
+    cached_routes_.insert({path_identifier, lru_routes_.begin()});
 
-    return cached_routes_.at(path_identifier);
+    return route;
 }
 
+void CachedRouter::print_stats(std::ostream& os) const
+{
+    os << "Route cache: " << stats_.hits << " hits, " << stats_.misses << " misses, "
+       << stats_.invalidations << " invalidations, " << stats_.evictions << " evictions" << std::endl;
+    router_impl_.print_stats(os);
+}
 
-
-size_t CachedRouter::PathIdentifier::hash::operator()(
-        const CachedRouter::PathIdentifier& x) const
+void CustomDPRouter::print_stats(std::ostream& os) const
 {
-    return 0
-            + std::hash<uint32_t>()(static_cast<uint32_t>(x.source_op))
-            + std::hash<uint32_t>()(static_cast<uint32_t>(x.source_cell.row))
-            + std::hash<uint32_t>()(static_cast<uint32_t>(x.source_cell.col))
-            + std::hash<uint32_t>()(static_cast<uint32_t>(x.target_op))
-            + std::hash<uint32_t>()(static_cast<uint32_t>(x.target_cell.row))
-            + std::hash<uint32_t>()(static_cast<uint32_t>(x.target_cell.col));
+    os << negative_route_cache_.stats() << std::endl;
 }
 
 
+
 std::optional<RoutingRegion>CustomDPRouter::find_routing_ancilla(
         const Slice& slice, PatchId source, PauliOperator source_op, PatchId target, PauliOperator target_op) const
 {
+    const RouteQuery query = RouteQuery::from_ids(slice, source, source_op, target, target_op);
+
+    // No need to search if the cells are cut off from each other on every slice of the layout
+    if(const StaticDistances* static_distances = slice.get_layout().static_distances())
+        if(!static_distances->may_be_connected(query.source_cell, query.target_cell))
+            return std::nullopt;
+
+    if(negative_route_cache_.known_to_fail(slice, query))
+        return std::nullopt;
+
+    auto route = search(slice, source, source_op, target, target_op);
+    if(!route)
+        negative_route_cache_.remember_failure(slice, query);
+    return route;
+}
 
+std::optional<RoutingRegion> CustomDPRouter::search(
+        const Slice& slice, PatchId source, PauliOperator source_op, PatchId target, PauliOperator target_op) const
+{
     using namespace lsqecc::custom_graph_search;
+
     switch(graph_search_provider_)
     {
     case GraphSearchProvider::Boost:
         return boost_graph_search::graph_search_route_ancilla(slice, source, source_op, target, target_op);
+    case GraphSearchProvider::BoostIncremental:
+        return boost_graph_search::graph_search_route_ancilla(slice, source, source_op, target, target_op, boost_incremental_graph_);
     case GraphSearchProvider::Djikstra:
-        return custom_graph_search::graph_search_route_ancilla(slice, source, source_op, target, target_op, Heuristic::None);
+        return custom_graph_search::graph_search_route_ancilla(slice, source, source_op, target, target_op, Heuristic::None, search_workspace_);
     case GraphSearchProvider::AStar:
-        return custom_graph_search::graph_search_route_ancilla(slice, source, source_op, target, target_op, Heuristic::Euclidean);
+        return custom_graph_search::graph_search_route_ancilla(slice, source, source_op, target, target_op, Heuristic::Euclidean, search_workspace_);
+    case GraphSearchProvider::BucketAStar:
+        return custom_graph_search::graph_search_route_ancilla(slice, source, source_op, target, target_op, Heuristic::Manhattan, search_workspace_);
+    case GraphSearchProvider::LandmarkAStar:
+        return custom_graph_search::graph_search_route_ancilla(slice, source, source_op, target, target_op, Heuristic::Landmarks, search_workspace_);
+    case GraphSearchProvider::Bitboard:
+        return bitboard_graph_search::graph_search_route_ancilla(slice, source, source_op, target, target_op, bitboard_search_workspace_);
     }
 
     LSTK_UNREACHABLE;
@@ -0,0 +1,139 @@
+#include <lsqecc/layout/static_distances.hpp>
+#include <lsqecc/layout/layout.hpp>
+
+#include <algorithm>
+#include <queue>
+#include <stdexcept>
+
+
+namespace lsqecc {
+
+
+StaticDistances::StaticDistances(const Layout& layout, size_t num_landmarks)
+: rows_(static_cast<size_t>(layout.furthest_cell().row+1)),
+  cols_(static_cast<size_t>(layout.furthest_cell().col+1)),
+  components_(rows_*cols_, 0)
+{
+    if(num_landmarks > max_landmarks)
+        throw std::logic_error(lstk::cat("At most ", max_landmarks, " landmarks are supported"));
+
+    for(const Cell& cell : layout.dead_location())
+        components_[index_of(cell)] = blocked;
+    for(const auto& region : layout.distillation_regions())
+        for(const auto& occupied_cell : region.sub_cells)
+            components_[index_of(occupied_cell.cell)] = blocked;
+
+    // Label components, numbered from 1 so that 0 means not yet visited
+    const Cell furthest_cell = layout.furthest_cell();
+    uint32_t num_components = 0;
+    std::queue<Cell> queue;
+    layout.for_each_cell([&](const Cell& start){
+        if(components_[index_of(start)] != 0) return;
+        components_[index_of(start)] = ++num_components;
+        queue.push(start);
+        while(!queue.empty())
+        {
+            const Cell cell = lstk::queue_pop(queue);
+            for(const Cell& neighbour : cell.get_neigbours_within_bounding_box_inclusive({0,0}, furthest_cell))
+            {
+                if(components_[index_of(neighbour)] != 0) continue;
+                components_[index_of(neighbour)] = num_components;
+                queue.push(neighbour);
+            }
+        }
+    });
+
+    // Farthest point landmarks: each new landmark is the cell furthest from all previous ones. Cells no landmark
+    // reaches count as furthest, so every component gets a landmark before any gets a second one
+    std::vector<DistanceField::Distance> closest_landmark(rows_*cols_, DistanceField::unreachable);
+    std::optional<Cell> first_unblocked;
+    layout.for_each_cell([&](const Cell& cell){
+        if(!first_unblocked && !is_blocked(cell)) first_unblocked = cell;
+    });
+    if(first_unblocked)
+    {
+        // Start from the cell furthest from an arbitrary one, which tends to be on the edge of the lattice
+        const DistanceField seed = breadth_first_distances({*first_unblocked});
+        Cell next_landmark = *first_unblocked;
+        layout.for_each_cell([&](const Cell& cell){
+            if(seed.at(cell) != DistanceField::unreachable && seed.at(cell) > seed.at(next_landmark))
+                next_landmark = cell;
+        });
+
+        while(landmark_fields_.size() < num_landmarks)
+        {
+            landmark_fields_.push_back(breadth_first_distances({next_landmark}));
+
+            std::optional<Cell> furthest;
+            layout.for_each_cell([&](const Cell& cell){
+                if(is_blocked(cell)) return;
+                auto& closest = closest_landmark[index_of(cell)];
+                closest = std::min(closest, landmark_fields_.back().at(cell));
+                if(closest != 0 && (!furthest || closest > closest_landmark[index_of(*furthest)]))
+                    furthest = cell;
+            });
+            if(!furthest) break; // Every cell is a landmark
+            next_landmark = *furthest;
+        }
+    }
+
+    if(layout.predistilled_y_states().size()*rows_*cols_ <= max_y_state_field_entries)
+        for(const Cell& y_state : layout.predistilled_y_states())
+            y_state_fields_.push_back(breadth_first_distances({y_state}));
+}
+
+
+DistanceField StaticDistances::breadth_first_distances(const std::vector<Cell>& sources) const
+{
+    const Cell furthest_cell = Cell::from_ints(rows_-1, cols_-1);
+    std::vector<DistanceField::Distance> distances(rows_*cols_, DistanceField::unreachable);
+
+    std::queue<Cell> queue;
+    for(const Cell& source : sources)
+    {
+        distances[index_of(source)] = 0;
+        queue.push(source);
+    }
+    while(!queue.empty())
+    {
+        const Cell cell = lstk::queue_pop(queue);
+        for(const Cell& neighbour : cell.get_neigbours_within_bounding_box_inclusive({0,0}, furthest_cell))
+        {
+            if(is_blocked(neighbour) || distances[index_of(neighbour)] != DistanceField::unreachable) continue;
+            distances[index_of(neighbour)] = distances[index_of(cell)]+1;
+            queue.push(neighbour);
+        }
+    }
+    return DistanceField{cols_, std::move(distances)};
+}
+
+
+bool StaticDistances::may_be_connected(const Cell& a, const Cell& b) const
+{
+    return is_blocked(a) || is_blocked(b) || components_[index_of(a)] == components_[index_of(b)];
+}
+
+
+StaticDistances::TargetHeuristic::TargetHeuristic(const StaticDistances& distances, const Cell& target)
+: distances_(distances), target_(target)
+{
+    for(size_t i = 0; i < distances_.landmark_fields_.size(); i++)
+        landmark_to_target_[i] = distances_.landmark_fields_[i].at(target);
+}
+
+DistanceField::Distance StaticDistances::TargetHeuristic::operator()(const Cell& cell) const
+{
+    auto best = static_cast<DistanceField::Distance>(std::abs(cell.row - target_.row) + std::abs(cell.col - target_.col));
+    for(size_t i = 0; i < distances_.landmark_fields_.size(); i++)
+    {
+        const DistanceField::Distance to_target = landmark_to_target_[i];
+        const DistanceField::Distance to_cell = distances_.landmark_fields_[i].at(cell);
+        if(to_target == DistanceField::unreachable || to_cell == DistanceField::unreachable)
+            continue;
+        best = std::max(best, to_target > to_cell ? to_target - to_cell : to_cell - to_target);
+    }
+    return best;
+}
+
+
+}
@@ -38,7 +38,7 @@ LSInstruction BoundaryRotationInjectionStream::get_next_instruction()
     LSInstruction new_instruction = source_->get_next_instruction();
     if(const auto* mpm = std::get_if<MultiPatchMeasurement>(&new_instruction.operation))
     {
-        for(const PatchId patch_id : new_instruction.get_operating_patches())
+        for(const PatchId patch_id : new_instruction.operating_patches())
         {
             if(exposed_operators_.contains(patch_id) && !exposed_operators_.at(patch_id).is_exposed(mpm->observable.at(patch_id)))
             {
@@ -54,8 +54,11 @@ LSInstruction BoundaryRotationInjectionStream::get_next_instruction()
         }
 
     }
-    
-    next_instructions_.push(new_instruction);
+
+    // Most instructions need no rotation and can skip the queue
+    if(next_instructions_.empty())
+        return new_instruction;
+    next_instructions_.push(std::move(new_instruction));
 
     return lstk::queue_pop(next_instructions_);
 }
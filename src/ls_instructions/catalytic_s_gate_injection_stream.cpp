@@ -74,12 +74,13 @@ LSInstruction CatalyticSGateInjectionStream::get_next_instruction()
     }
     else if (gate && gate->op == SingleQubitOp::Operator::H && core_qubits().contains(gate->target))
     {
-        next_instructions_.push(new_instruction);
-        next_instructions_.push({RotateSingleCellPatch{gate->target}});
+        const PatchId target = gate->target;
+        next_instructions_.push(std::move(new_instruction));
+        next_instructions_.push({RotateSingleCellPatch{target}});
     }
     else
     {
-        next_instructions_.push(new_instruction);
+        return new_instruction;
     }
 
     return lstk::queue_pop(next_instructions_);
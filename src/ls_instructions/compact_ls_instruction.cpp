@@ -0,0 +1,177 @@
+#include <lsqecc/ls_instructions/compact_ls_instruction.hpp>
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+
+namespace lsqecc {
+
+
+LSInstructionPayloads::Handle LSInstructionPayloads::store(LSInstruction&& instruction)
+{
+    Handle handle;
+    if(!free_handles_.empty())
+    {
+        handle = free_handles_.back();
+        free_handles_.pop_back();
+        payloads_[handle].emplace(std::move(instruction));
+    }
+    else
+    {
+        if(payloads_.size() >= std::numeric_limits<Handle>::max())
+            throw std::length_error("Too many instruction payloads");
+        handle = static_cast<Handle>(payloads_.size());
+        payloads_.emplace_back(std::move(instruction));
+    }
+    size_++;
+    return handle;
+}
+
+LSInstruction LSInstructionPayloads::take(Handle handle)
+{
+    if(handle >= payloads_.size() || !payloads_[handle])
+        throw std::out_of_range("No instruction payload with handle " + std::to_string(handle));
+    LSInstruction instruction = std::move(*payloads_[handle]);
+    payloads_[handle].reset();
+    free_handles_.push_back(handle);
+    size_--;
+    return instruction;
+}
+
+const LSInstruction& LSInstructionPayloads::at(Handle handle) const
+{
+    if(handle >= payloads_.size() || !payloads_[handle])
+        throw std::out_of_range("No instruction payload with handle " + std::to_string(handle));
+    return *payloads_[handle];
+}
+
+
+bool CompactLSInstruction::fits_inline(const LSInstruction& instruction)
+{
+    if(instruction.wait_at_most_for > std::numeric_limits<uint32_t>::max())
+        return false;
+    if(const auto* m = std::get_if<MultiPatchMeasurement>(&instruction.operation))
+        return m->observable.size() <= max_inline_patches;
+    return std::holds_alternative<SinglePatchMeasurement>(instruction.operation)
+        || std::holds_alternative<PatchInit>(instruction.operation)
+        || std::holds_alternative<MagicStateRequest>(instruction.operation)
+        || std::holds_alternative<YStateRequest>(instruction.operation)
+        || std::holds_alternative<SingleQubitOp>(instruction.operation)
+        || std::holds_alternative<RotateSingleCellPatch>(instruction.operation);
+}
+
+
+CompactLSInstruction CompactLSInstruction::from(LSInstruction&& instruction, LSInstructionPayloads& payloads)
+{
+    CompactLSInstruction compact;
+    if(!fits_inline(instruction))
+    {
+        compact.payload = payloads.store(std::move(instruction));
+        return compact;
+    }
+    compact.wait_at_most_for = static_cast<uint32_t>(instruction.wait_at_most_for);
+
+    if(const auto* s = std::get_if<SinglePatchMeasurement>(&instruction.operation))
+    {
+        compact.kind = Kind::SinglePatchMeasurement;
+        compact.patches[0] = s->target;
+        compact.paulis[0] = s->observable;
+        compact.flags = s->is_negative ? is_negative : 0;
+    }
+    else if(const auto* m = std::get_if<MultiPatchMeasurement>(&instruction.operation))
+    {
+        compact.kind = Kind::MultiPatchMeasurement;
+        for(const auto& [patch, op]: m->observable)
+        {
+            compact.patches[compact.num_patches] = patch;
+            compact.paulis[compact.num_patches] = op;
+            compact.num_patches++;
+        }
+        compact.flags = m->is_negative ? is_negative : 0;
+    }
+    else if(const auto* init = std::get_if<PatchInit>(&instruction.operation))
+    {
+        compact.kind = Kind::PatchInit;
+        compact.patches[0] = init->target;
+        compact.flags = init->state == PatchInit::InitializeableStates::Plus ? init_plus : 0;
+        if(init->place_next_to)
+        {
+            compact.flags |= has_place_next_to;
+            compact.patches[1] = init->place_next_to->target;
+            compact.paulis[1] = init->place_next_to->op;
+        }
+    }
+    else if(const auto* magic = std::get_if<MagicStateRequest>(&instruction.operation))
+    {
+        compact.kind = Kind::MagicStateRequest;
+        compact.patches[0] = magic->target;
+    }
+    else if(const auto* y = std::get_if<YStateRequest>(&instruction.operation))
+    {
+        compact.kind = Kind::YStateRequest;
+        compact.patches[0] = y->target;
+        compact.patches[1] = y->near_patch;
+    }
+    else if(const auto* g = std::get_if<SingleQubitOp>(&instruction.operation))
+    {
+        compact.kind = Kind::SingleQubitOp;
+        compact.patches[0] = g->target;
+        compact.gate = g->op;
+        compact.flags = g->is_dagger ? is_dagger : 0;
+    }
+    else if(const auto* rotate = std::get_if<RotateSingleCellPatch>(&instruction.operation))
+    {
+        compact.kind = Kind::RotateSingleCellPatch;
+        compact.patches[0] = rotate->target;
+    }
+
+    return compact;
+}
+
+
+LSInstruction CompactLSInstruction::to_instruction(LSInstructionPayloads& payloads) const
+{
+    LSInstruction instruction{.operation = RotateSingleCellPatch{patches[0]}, .wait_at_most_for = wait_at_most_for};
+    switch(kind)
+    {
+        case Kind::SinglePatchMeasurement:
+            instruction.operation = SinglePatchMeasurement{patches[0], paulis[0], (flags & is_negative) != 0};
+            break;
+        case Kind::MultiPatchMeasurement:
+        {
+            MultiPatchMeasurement measurement{.observable = {}, .is_negative = (flags & is_negative) != 0};
+            for(size_t i = 0; i < num_patches; i++)
+                measurement.observable.insert({patches[i], paulis[i]});
+            instruction.operation = std::move(measurement);
+            break;
+        }
+        case Kind::PatchInit:
+        {
+            PatchInit init{
+                    .target = patches[0],
+                    .state = (flags & init_plus) ? PatchInit::InitializeableStates::Plus : PatchInit::InitializeableStates::Zero};
+            if(flags & has_place_next_to)
+                init.place_next_to = PlaceNexTo{patches[1], paulis[1]};
+            instruction.operation = init;
+            break;
+        }
+        case Kind::MagicStateRequest:
+            instruction.operation = MagicStateRequest{patches[0]};
+            break;
+        case Kind::YStateRequest:
+            instruction.operation = YStateRequest{patches[0], patches[1]};
+            break;
+        case Kind::SingleQubitOp:
+            instruction.operation = SingleQubitOp{patches[0], gate, (flags & is_dagger) != 0};
+            break;
+        case Kind::RotateSingleCellPatch:
+            break;
+        case Kind::Payload:
+            return payloads.take(payload);
+    }
+    return instruction;
+}
+
+
+} // namespace lsqecc
@@ -181,6 +181,20 @@ const tsl::ordered_set<PatchId>& LSInstructionStreamFromGateStream::core_qubits(
     return core_qubits_;
 }
 
+LSInstructionStreamFromVector::LSInstructionStreamFromVector(
+        std::vector<LSInstruction> instructions,
+        tsl::ordered_set<PatchId> core_qubits)
+: instructions_(std::move(instructions)),
+  core_qubits_(std::move(core_qubits))
+{
+}
+
+LSInstruction LSInstructionStreamFromVector::get_next_instruction()
+{
+    // Each instruction is only read once
+    return std::move(instructions_.at(next_instruction_++));
+}
+
 std::ostream& print_all_ls_instructions_to_string(std::ostream& os, std::unique_ptr<LSInstructionStream>&& ls_instruction_stream)
 {
     while(ls_instruction_stream->has_next_instruction())
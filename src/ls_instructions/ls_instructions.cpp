@@ -7,9 +7,9 @@
 namespace lsqecc {
 
 
-tsl::ordered_set<PatchId> LSInstruction::get_operating_patches() const
+LSInstruction::OperatingPatches LSInstruction::operating_patches() const
 {
-    tsl::ordered_set<PatchId> ret;
+    OperatingPatches ret;
     std::visit(lstk::overloaded{
         [&](const SinglePatchMeasurement& op){
             ret.insert(op.target);
@@ -54,6 +54,12 @@ tsl::ordered_set<PatchId> LSInstruction::get_operating_patches() const
     return ret;
 }
 
+tsl::ordered_set<PatchId> LSInstruction::get_operating_patches() const
+{
+    const OperatingPatches patches = operating_patches();
+    return {patches.begin(), patches.end()};
+}
+
 std::ostream& operator<<(std::ostream& os, const LSInstruction& instruction)
 {
     std::visit([&os](auto&& op){ os << op;}, instruction.operation);
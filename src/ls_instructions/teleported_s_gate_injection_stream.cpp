@@ -55,7 +55,7 @@ LSInstruction TeleportedSGateInjectionStream::get_next_instruction()
     }
     else
     {
-        next_instructions_.push(new_instruction);
+        return new_instruction;
     }
 
     return lstk::queue_pop(next_instructions_);
@@ -0,0 +1,86 @@
+#include <lsqecc/ls_instructions/threaded_ls_instruction_stream.hpp>
+
+#include <system_error>
+
+namespace lsqecc
+{
+
+ThreadedLSInstructionStream::ThreadedLSInstructionStream(
+        std::unique_ptr<LSInstructionStream>&& source,
+        size_t queue_capacity)
+    : source_(std::move(source)),
+      core_qubits_(source_->core_qubits()),
+      queue_(std::make_unique<SpscQueue<CompactLSInstruction>>(queue_capacity))
+{
+    try
+    {
+        producer_ = std::thread{[this](){produce();}};
+    }
+    catch (const std::system_error&)
+    {
+        // No threads on this platform, get_next_instruction reads source_ directly
+    }
+}
+
+ThreadedLSInstructionStream::~ThreadedLSInstructionStream()
+{
+    if(producer_.joinable())
+    {
+        queue_->cancel();
+        producer_.join();
+    }
+}
+
+void ThreadedLSInstructionStream::produce()
+{
+    try
+    {
+        while(source_->has_next_instruction())
+        {
+            LSInstruction instruction = source_->get_next_instruction();
+            CompactLSInstruction compact;
+            {
+                // The payload table is only touched for instructions that don't fit inline
+                std::unique_lock<std::mutex> lock{payloads_mutex_, std::defer_lock};
+                if(!CompactLSInstruction::fits_inline(instruction))
+                    lock.lock();
+                compact = CompactLSInstruction::from(std::move(instruction), payloads_);
+            }
+            if(!queue_->push(std::move(compact)))
+                break;
+        }
+    }
+    catch (...)
+    {
+        source_error_ = std::current_exception();
+    }
+    queue_->close();
+}
+
+LSInstruction ThreadedLSInstructionStream::get_next_instruction()
+{
+    if(!is_threaded())
+        return source_->get_next_instruction();
+
+    if(!has_next_instruction())
+        throw std::logic_error{"ThreadedLSInstructionStream: No more instructions from source"};
+    const CompactLSInstruction compact = *queue_->pop();
+    if(compact.kind != CompactLSInstruction::Kind::Payload)
+        return compact.to_instruction(payloads_);
+    std::lock_guard<std::mutex> lock{payloads_mutex_};
+    return compact.to_instruction(payloads_);
+}
+
+bool ThreadedLSInstructionStream::has_next_instruction() const
+{
+    if(!is_threaded())
+        return source_->has_next_instruction();
+
+    if(queue_->wait_for_value())
+        return true;
+    if(source_error_)
+        std::rethrow_exception(source_error_);
+    return false;
+}
+
+}
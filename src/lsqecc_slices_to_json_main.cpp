@@ -0,0 +1,85 @@
+#include <lsqecc/patches/slice_binary.hpp>
+
+#include <argparse/argparse.h>
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+
+
+int main(int argc, const char* argv[])
+{
+    argparse::ArgumentParser parser(argv[0], "Convert slices written with --slice-format binary to JSON");
+    parser.add_argument()
+            .names({"-i", "--input"})
+            .description("File with binary slices. If not provided will read them from stdin")
+            .required(false);
+    parser.add_argument()
+            .names({"-o", "--output"})
+            .description("File name of output. When not provided outputs to stdout")
+            .required(false);
+    parser.add_argument()
+            .names({"--first-slice"})
+            .description("Number of the first slice to convert, counting from 0 (default 0). Past 0 the input must be a file")
+            .required(false);
+    parser.add_argument()
+            .names({"--num-slices"})
+            .description("Convert at most this many slices (default all)")
+            .required(false);
+    parser.add_argument()
+            .names({"--compact-json"})
+            .description("Write the JSON of each slice on a single line, without indentation")
+            .required(false);
+    parser.enable_help();
+
+    auto err = parser.parse(argc, argv);
+    if (err)
+    {
+        std::cerr << err << std::endl;
+        parser.print_help();
+        return -1;
+    }
+    if (parser.exists("help"))
+    {
+        parser.print_help();
+        return 0;
+    }
+
+    std::istream* in = &std::cin;
+    std::unique_ptr<std::ifstream> in_file;
+    if (parser.exists("i"))
+    {
+        in_file = std::make_unique<std::ifstream>(parser.get<std::string>("i"), std::ios::in | std::ios::binary);
+        if (in_file->fail())
+        {
+            std::cerr << "Could not open slice file: " << parser.get<std::string>("i") << std::endl;
+            return -1;
+        }
+        in = in_file.get();
+    }
+
+    std::ostream* out = &std::cout;
+    std::unique_ptr<std::ofstream> out_file;
+    if (parser.exists("o"))
+    {
+        out_file = std::make_unique<std::ofstream>(parser.get<std::string>("o"));
+        out = out_file.get();
+    }
+
+    try
+    {
+        lsqecc::binary_slices_to_json(
+                *in, *out,
+                parser.exists("compact-json") ? lsqecc::JsonStyle::Compact : lsqecc::JsonStyle::Indented,
+                parser.exists("first-slice") ? parser.get<size_t>("first-slice") : 0,
+                parser.exists("num-slices") ? parser.get<size_t>("num-slices") : SIZE_MAX);
+    }
+    catch (const std::runtime_error& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return -1;
+    }
+    return 0;
+}
@@ -1,5 +1,8 @@
 #include <lsqecc/patches/dense_patch_computation.hpp>
 #include <lsqecc/dag/domain_dags.hpp>
+#include <lsqecc/dag/critical_path.hpp>
+
+#include <cppitertools/itertools.hpp>
 
 namespace lsqecc
 {
@@ -34,7 +37,7 @@ std::optional<Cell> place_ancilla_next_to(const DenseSlice& slice, PatchId targe
     for(const Cell& possible_ancilla_location : slice.get_neigbours_within_slice(target_cell))
     {
         auto boundary = slice.get_boundary_between(target_cell, possible_ancilla_location);
-        if(boundary && boundary->get().boundary_type == boundary_for_operator(boundary_op) && slice.is_cell_free(possible_ancilla_location))
+        if(boundary && boundary->boundary_type == boundary_for_operator(boundary_op) && slice.is_cell_free(possible_ancilla_location))
             return possible_ancilla_location;
     }
     return std::nullopt;
@@ -42,22 +45,10 @@ std::optional<Cell> place_ancilla_next_to(const DenseSlice& slice, PatchId targe
 
 void advance_slice(DenseSlice& slice, const Layout& layout)
 {
-    slice.traverse_cells_mut([&](const Cell& c, std::optional<DensePatch>& p) {
-        if(!p) return;
-        if(p->activity == PatchActivity::Unitary)
-            p->activity = PatchActivity::None;
-
-        p->boundaries.top.is_active = false;
-        p->boundaries.bottom.is_active = false;
-        p->boundaries.left.is_active = false;
-        p->boundaries.right.is_active = false;
-
-        if(p->type == PatchType::Routing || p->activity == PatchActivity::Measurement)
-        {
-            p = std::nullopt;
-            return;
-        }
-    });
+    slice.clear_transient_patches();
+#ifdef LSQECC_CHECK_SLICE_CONSISTENCY
+    slice.verify_no_transient_state();
+#endif
 
     size_t distillation_region_index = 0;
     for (auto& time_to_magic_state_here: slice.time_to_next_magic_state_by_distillation_region)
@@ -65,10 +56,10 @@ void advance_slice(DenseSlice& slice, const Layout& layout)
         if (layout.magic_states_reserved()) {
             for (const Cell& cell: layout.distilled_state_locations(distillation_region_index)) {
                 if (slice.is_cell_free(cell)) {
-                    slice.patch_at(cell) = DensePatch{
+                    slice.set_patch(cell, DensePatch{
                         Patch{PatchType::Distillation,PatchActivity::Distillation,std::nullopt},
                         CellBoundaries{Boundary{BoundaryType::Connected, false},Boundary{BoundaryType::Connected, false},
-                            Boundary{BoundaryType::Connected, false},Boundary{BoundaryType::Connected, false}}};
+                            Boundary{BoundaryType::Connected, false},Boundary{BoundaryType::Connected, false}}});
                 }
             }            
         }
@@ -90,6 +81,10 @@ void advance_slice(DenseSlice& slice, const Layout& layout)
 
         distillation_region_index++;
     }
+
+#ifdef LSQECC_CHECK_SLICE_CONSISTENCY
+    slice.verify_patch_id_index();
+#endif
 }
 
 
@@ -101,13 +96,13 @@ void stitch_boundaries(
 {
     if (routing_region.cells.empty())
     {
-        slice.get_boundary_between(source_cell,target_cell)->get().is_active=true;
-        slice.get_boundary_between(target_cell,source_cell)->get().is_active=true;
+        slice.activate_boundary_between(source_cell,target_cell);
+        slice.activate_boundary_between(target_cell,source_cell);
     }
     else
     {
-        slice.get_boundary_between(source_cell,routing_region.cells.back().cell)->get().is_active=true;
-        slice.get_boundary_between(target_cell,routing_region.cells.front().cell)->get().is_active=true;
+        slice.activate_boundary_between(source_cell,routing_region.cells.back().cell);
+        slice.activate_boundary_between(target_cell,routing_region.cells.front().cell);
     }
 }
 
@@ -131,7 +126,7 @@ bool merge_patches(
 {
 
     // TODO remove duplicate cell/patch search
-    if(slice.get_patch_by_id(source)->get().is_active() || slice.get_patch_by_id(target)->get().is_active())
+    if(slice.get_patch_by_id(source)->is_active() || slice.get_patch_by_id(target)->is_active())
         return false;
 
     auto routing_region = router.find_routing_ancilla(slice, source, source_op, target, target_op);
@@ -154,6 +149,14 @@ struct InstructionApplicationResult
     std::vector<LSInstruction> followup_instructions;
 };
 
+// Initializer lists can only be copied from, which would copy the routing regions of busy regions once more
+InstructionApplicationResult followed_by(LSInstruction&& followup)
+{
+    InstructionApplicationResult result;
+    result.followup_instructions.push_back(std::move(followup));
+    return result;
+}
+
 InstructionApplicationResult try_apply_local_instruction(
         DenseSlice& slice,
         LocalInstruction::LocalLSInstruction instruction,
@@ -176,8 +179,8 @@ InstructionApplicationResult try_apply_local_instruction(
 
         slice.place_sparse_patch(LayoutHelpers::basic_square_patch(bellprep->cell1, bellprep->side1), false);
         slice.place_sparse_patch(LayoutHelpers::basic_square_patch(bellprep->cell2, bellprep->side2), false);
-        slice.get_boundary_between_or_fail(bellprep->cell1, bellprep->cell2).get().is_active=true;
-        slice.get_boundary_between_or_fail(bellprep->cell2, bellprep->cell1).get().is_active=true;
+        slice.activate_boundary_between(bellprep->cell1, bellprep->cell2);
+        slice.activate_boundary_between(bellprep->cell2, bellprep->cell1);
 
         return {nullptr, {}};
     }
@@ -192,10 +195,10 @@ InstructionApplicationResult try_apply_local_instruction(
         {
             return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; Patch at ", bellmeas->cell2, " is active")), {}};
         }
-        slice.get_boundary_between_or_fail(bellmeas->cell1,bellmeas->cell2).get().is_active=true;
-        slice.get_boundary_between_or_fail(bellmeas->cell2,bellmeas->cell1).get().is_active=true;
-        slice.patch_at(bellmeas->cell1).value().activity = PatchActivity::Measurement;
-        slice.patch_at(bellmeas->cell2).value().activity = PatchActivity::Measurement;
+        slice.activate_boundary_between(bellmeas->cell1,bellmeas->cell2);
+        slice.activate_boundary_between(bellmeas->cell2,bellmeas->cell1);
+        slice.set_patch_activity(bellmeas->cell1, PatchActivity::Measurement);
+        slice.set_patch_activity(bellmeas->cell2, PatchActivity::Measurement);
 
         return {nullptr, {}};
     }
@@ -212,10 +215,10 @@ InstructionApplicationResult try_apply_local_instruction(
         SparsePatch new_patch = LayoutHelpers::basic_square_patch(move->target_cell);
         new_patch.id = move->new_id_for_target ? move->new_id_for_target : slice.patch_at(move->source_cell)->id;
         slice.place_sparse_patch(new_patch, false);
-        slice.get_boundary_between(move->source_cell, move->target_cell)->get().is_active=true;
-        slice.get_boundary_between(move->target_cell, move->source_cell)->get().is_active=true;
-        slice.patch_at(move->source_cell)->activity = PatchActivity::Measurement;
-        slice.patch_at(move->source_cell)->id = std::nullopt;
+        slice.activate_boundary_between(move->source_cell, move->target_cell);
+        slice.activate_boundary_between(move->target_cell, move->source_cell);
+        slice.set_patch_activity(move->source_cell, PatchActivity::Measurement);
+        slice.set_patch_id(move->source_cell, std::nullopt);
         return {nullptr, {}};
     }
     else if (const auto* localmeas = std::get_if<LocalInstruction::TwoPatchMeasure>(&instruction.operation))
@@ -228,8 +231,8 @@ InstructionApplicationResult try_apply_local_instruction(
         {
             return {std::make_unique<std::runtime_error>(lstk::cat(instruction, "; Patch at ", localmeas->cell2, " is active")), {}};
         }
-        slice.get_boundary_between_or_fail(localmeas->cell1,localmeas->cell2).get().is_active=true;
-        slice.get_boundary_between_or_fail(localmeas->cell2,localmeas->cell1).get().is_active=true;
+        slice.activate_boundary_between(localmeas->cell1,localmeas->cell2);
+        slice.activate_boundary_between(localmeas->cell2,localmeas->cell1);
 
         return {nullptr, {}};
 }
@@ -250,39 +253,40 @@ InstructionApplicationResult try_apply_instruction_direct_followup(
     if (const auto* s = std::get_if<SinglePatchMeasurement>(&instruction.operation))
     {
 
-        auto maybe_target_patch = slice.get_patch_by_id(s->target);
-        if(!maybe_target_patch)
+        auto target_cell = slice.get_cell_by_id(s->target);
+        if(!target_cell)
             return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; Patch ", s->target, " not on lattice")), {}};
-        auto& target_patch = maybe_target_patch->get();
 
-        if (target_patch.is_active())
+        if (slice.patch_at(*target_cell)->is_active())
             return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; Patch ", s->target, " is active")), {}};
-        target_patch.activity = PatchActivity::Measurement;
+        slice.set_patch_activity(*target_cell, PatchActivity::Measurement);
         return {nullptr, {}};
     }
     else if (const auto* p = std::get_if<SingleQubitOp>(&instruction.operation))
     {
-        auto maybe_target_patch = slice.get_patch_by_id(p->target);
-        if (!maybe_target_patch)
+        auto target_cell = slice.get_cell_by_id(p->target);
+        if (!target_cell)
             return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; Patch ", p->target, " not on lattice")), {}};
-        auto& target_patch = maybe_target_patch->get();
 
         if (p->op==SingleQubitOp::Operator::S)
         {
             if (!merge_patches(slice, router, p->target, PauliOperator::X, p->target, PauliOperator::Z))
                 return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; Could not do S gate routing on ", p->target)),
                         {}};
-            LSInstruction corrective_term{SingleQubitOp{p->target, SingleQubitOp::Operator::Z}};
-            return {nullptr, {corrective_term}};
+            return followed_by({SingleQubitOp{p->target, SingleQubitOp::Operator::Z}});
         }
         else
         {
+            DensePatch target_patch = slice.patch_at(*target_cell).value();
             if (target_patch.is_active())
                 return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; Patch ", p->target, " is active")), {}};
 
-            target_patch.activity = PatchActivity::Unitary;
+            slice.set_patch_activity(*target_cell, PatchActivity::Unitary);
             if (p->op == SingleQubitOp::Operator::H)
+            {
                 target_patch.boundaries.instant_rotate();
+                slice.set_patch_boundaries(*target_cell, target_patch.boundaries);
+            }
                 
             return {nullptr, {}};
         }
@@ -329,9 +333,8 @@ InstructionApplicationResult try_apply_instruction_direct_followup(
                 : find_free_ancilla_location(layout, slice);
         if (!location) return {std::make_unique<std::runtime_error>(lstk::cat(instruction,"; Could not allocate ancilla")), {}};
 
-        slice.patch_at(*location);
         slice.place_sparse_patch(LayoutHelpers::basic_square_patch(*location), false);
-        slice.patch_at(*location)->id = init->target;
+        slice.set_patch_id(*location, init->target);
 
         return {nullptr, {}};
     }
@@ -354,7 +357,7 @@ InstructionApplicationResult try_apply_instruction_direct_followup(
             std::vector<SparsePatch> bell_state;
             bell_state.push_back(LayoutHelpers::basic_square_patch(routing_region->cells.back().cell, bell_init->side1));
             bell_state.push_back(LayoutHelpers::basic_square_patch(routing_region->cells.front().cell, bell_init->side2));
-            return {nullptr, {{{BusyRegion{routing_region.value(), 1, bell_state}}}}};
+            return followed_by({BusyRegion{std::move(*routing_region), 1, std::move(bell_state)}});
         }
         else 
         {
@@ -435,18 +438,18 @@ InstructionApplicationResult try_apply_instruction_direct_followup(
 
         if (slice.patch_at(target_cell)->activity == PatchActivity::Unitary)
         {
-            slice.patch_at(target_cell)->activity = PatchActivity::None;
+            slice.set_patch_activity(target_cell, PatchActivity::None);
         }
 
         auto stages{LayoutHelpers::single_patch_rotation_a_la_litinski(
                 slice.patch_at(target_cell)->to_sparse_patch(target_cell), *free_neighbour)};
 
-        slice.patch_at(target_cell) = std::nullopt;
+        slice.clear_cell(target_cell);
         apply_routing_region(slice,stages.stage_1);
 
         std::vector<SparsePatch> final_state{stages.final_state};
 
-        return {nullptr, {{BusyRegion{std::move(stages.stage_2), 1, final_state}}}};
+        return followed_by({BusyRegion{std::move(stages.stage_2), 1, std::move(final_state)}});
     }
     else if (auto* mr = std::get_if<MagicStateRequest>(&instruction.operation))
     {
@@ -456,10 +459,11 @@ InstructionApplicationResult try_apply_instruction_direct_followup(
         if (slice.magic_state_queue.size()>0)
         {
             const Cell newly_bound_magic_state_cell = lstk::queue_pop(slice.magic_state_queue);
-            auto& newly_bound_magic_state = slice.patch_at(newly_bound_magic_state_cell).value();
+            auto newly_bound_magic_state = slice.patch_at(newly_bound_magic_state_cell).value();
             newly_bound_magic_state.id = mr->target;
             newly_bound_magic_state.type = PatchType::Qubit;
             newly_bound_magic_state.activity = PatchActivity::None;
+            slice.set_patch(newly_bound_magic_state_cell, newly_bound_magic_state);
             return {nullptr, {}};
         }
         else
@@ -470,23 +474,30 @@ InstructionApplicationResult try_apply_instruction_direct_followup(
     else if (auto* yr = std::get_if<YStateRequest>(&instruction.operation))
     {
         // Unbind Y state patch if already bound
-        if (slice.get_patch_by_id(yr->target))
+        if (auto bound_cell = slice.get_cell_by_id(yr->target))
         {
-            slice.get_patch_by_id(yr->target)->get().id = std::nullopt;
+            slice.set_patch_id(*bound_cell, std::nullopt);
             return{nullptr, {}};
         }
-        // Otherwise, get minimum (L1) distance unbound Y state patch
+        // Otherwise, get the closest unbound Y state patch, by distance on the empty lattice if the layout has it
+        // precomputed and L1 distance if not
         else 
         {
+            const Cell near_cell = slice.get_cell_by_id(yr->near_patch).value();
+            const StaticDistances* static_distances = layout.static_distances();
+            const bool use_static_distances = static_distances && static_distances->has_y_state_fields();
+
             std::optional<Cell> min_cell;
             double min_dist = std::numeric_limits<double>::max();
             double dist;
             // 
-            for (const Cell& cell : layout.predistilled_y_states())
+            for (const auto& [y_state_idx, cell] : iter::enumerate(layout.predistilled_y_states()))
             {
                 if (!slice.patch_at(cell)->id.has_value() && !slice.patch_at(cell)->is_active())
                 {
-                    dist = abs(cell.col - slice.get_cell_by_id(yr->near_patch).value().col) + abs(cell.row - slice.get_cell_by_id(yr->near_patch).value().row);
+                    dist = use_static_distances
+                           ? static_distances->from_y_state(y_state_idx).at(near_cell)
+                           : abs(cell.col - near_cell.col) + abs(cell.row - near_cell.row);
                     if (dist < min_dist)
                     {
                         min_dist = dist;
@@ -497,7 +508,7 @@ InstructionApplicationResult try_apply_instruction_direct_followup(
 
             if (min_cell)
             {
-                slice.patch_at(min_cell.value()).value().id = yr->target;
+                slice.set_patch_id(min_cell.value(), yr->target);
                 return {nullptr, {}};
             }
             else 
@@ -542,16 +553,24 @@ InstructionApplicationResult try_apply_instruction_direct_followup(
                             {instruction}};
 
             apply_routing_region(slice, busy_region->region);
-            return {nullptr,{{BusyRegion{
+            return followed_by({BusyRegion{
                     busy_region->region,
                     busy_region->steps_to_clear-1,
-                    busy_region->state_after_clearing}}}};
+                    busy_region->state_after_clearing}});
         }
 
     }
     LSTK_UNREACHABLE;
 }
 
+// Visitors see the cells that changed since the previous slice they were given
+void visit_slice(DenseSlice& slice, const DenseSliceVisitor& slice_visitor)
+{
+    slice_visitor(slice);
+    slice.clear_changed_cells();
+}
+
+
 void run_through_dense_slices_streamed(
         LSInstructionStream&& instruction_stream,
         bool local_instructions,
@@ -582,30 +601,47 @@ void run_through_dense_slices_streamed(
 
         if (!application_result.followup_instructions.empty())
         {
-            slice_visitor(slice);
+            visit_slice(slice, slice_visitor);
             advance_slice(slice, layout);
             res.slice_count_++;
 
             for (auto&& i: application_result.followup_instructions)
-                future_instructions.push_back(i);
+                future_instructions.push_back(std::move(i));
         }
         else if (application_result.maybe_error)
         {
-            slice_visitor(slice);
+            visit_slice(slice, slice_visitor);
             if (instruction.wait_at_most_for == 0)
                 throw std::runtime_error{application_result.maybe_error->what()};
             instruction.wait_at_most_for--;
-            future_instructions.push_front(instruction);
+            future_instructions.push_front(std::move(instruction));
             advance_slice(slice, layout);
         }
     }
-    slice_visitor(slice);
+    visit_slice(slice, slice_visitor);
+}
+
+
+// Instructions that commute can be ready together while sharing a patch, only one of them can use it in a slice
+bool uses_active_patch(const DenseSlice& slice, const LSInstruction& instruction)
+{
+    for (PatchId id: instruction.operating_patches())
+    {
+        auto patch = slice.get_patch_by_id(id);
+        if (patch && patch->is_active())
+            return true;
+    }
+    return false;
 }
 
 
+/*
+ * Keeps at most dag_options.window instructions of the stream in the dependency dag, reading more in at the start of
+ * each slice as applied ones leave it. Without a window the whole stream is read before the first slice.
+ */
 void run_through_dense_slices_dag(
-        dag::DependencyDag<LSInstruction>&& dag,
-        const tsl::ordered_set<PatchId>& core_qubits,
+        LSInstructionStream& instruction_stream,
+        const DagPipelineOptions& dag_options,
         bool local_instructions,
         const Layout& layout,
         Router& router,
@@ -615,8 +651,27 @@ void run_through_dense_slices_dag(
         bool graceful,
         DensePatchComputationResult& res)
 {
-    DenseSlice slice{layout, core_qubits};
+    DenseSlice slice{layout, instruction_stream.core_qubits()};
+    res.dag_scheduler_ = dag_options.scheduler;
+
+    dag::DependencyDag<LSInstruction, dag::DenseDirectedGraph> dag;
+    std::optional<dag::CriticalPathPriorities> priorities;
+    if (dag_options.scheduler == DagScheduler::CriticalPath)
+        priorities.emplace();
 
+    auto refill = [&]()
+    {
+        size_t added = 0;
+        while (instruction_stream.has_next_instruction() && (!dag_options.window || dag.size() < *dag_options.window))
+        {
+            dag.push_instruction_based_on_local_commutation(instruction_stream.get_next_instruction());
+            added++;
+        }
+        if (priorities)
+            priorities->instructions_added(dag, added);
+    };
+
+    std::vector<dag::label_t> non_proximate_instructions;
     std::unordered_map<dag::label_t, size_t> attempts_per_instruction;
     auto increment_attempts = [&attempts_per_instruction](dag::label_t label)
     {
@@ -625,6 +680,11 @@ void run_through_dense_slices_dag(
         attempts_per_instruction[label]++;
     };
 
+    // Instructions that commute can queue up on the same patches for many slices, so failures only count as attempts
+    // in slices where nothing could be applied at all
+    std::vector<std::pair<dag::label_t, std::unique_ptr<std::exception>>> failed_this_slice;
+    bool applied_this_slice = false;
+
     auto handle_followup_instructions = [&dag](dag::label_t instruction_label, std::vector<LSInstruction>&& followup_instructions)
     {
         if (!followup_instructions.empty())
@@ -637,6 +697,7 @@ void run_through_dense_slices_dag(
     };
 
 
+    refill();
     while (!dag.empty())
     {
         // Apply all proximate instructions
@@ -655,43 +716,62 @@ void run_through_dense_slices_dag(
             {
                 res.ls_instructions_count_++;
                 instruction_visitor(instruction);
+                applied_this_slice = true;
             }
             handle_followup_instructions(instruction_label, std::move(application_result.followup_instructions));
             
         }
 
         // Now apply all non-proximate instructions, where possible
-        auto non_proximate_instructions = dag.applicable_instructions();
+        // Snapshot, as applying instructions makes others ready that have to wait for the next slice
+        non_proximate_instructions.assign(dag.ready_instructions().begin(), dag.ready_instructions().end());
+        if (priorities)
+            priorities->sort(non_proximate_instructions);
         for (dag::label_t instruction_label: non_proximate_instructions)
         {
             LSInstruction& instruction = dag.at(instruction_label);
+            // Not an attempt, the patch is free again next slice
+            if (uses_active_patch(slice, instruction))
+                continue;
             auto application_result = try_apply_instruction_direct_followup(slice, instruction, local_instructions, layout, router);
             if (application_result.maybe_error)
+                failed_this_slice.emplace_back(instruction_label, std::move(application_result.maybe_error));
+            else
+            {
+                res.ls_instructions_count_++;
+                instruction_visitor(instruction);
+                applied_this_slice = true;
+                attempts_per_instruction.erase(instruction_label);
+                handle_followup_instructions(instruction_label, std::move(application_result.followup_instructions));
+            }
+        }
+
+        if (!applied_this_slice)
+        {
+            for (auto& [instruction_label, error]: failed_this_slice)
             {
                 increment_attempts(instruction_label);
                 if (attempts_per_instruction[instruction_label] > MAX_INSTRUCTION_APPLICATION_RETRIES_DAG_PIPELINE)
                 {
                     throw std::runtime_error{lstk::cat(
                         "Could not apply non-proximate instruction after ",
-                        MAX_INSTRUCTION_APPLICATION_RETRIES_DAG_PIPELINE," retries:\n",
-                        instruction,"\n",
+                        MAX_INSTRUCTION_APPLICATION_RETRIES_DAG_PIPELINE," retries in slices where nothing could be applied:\n",
+                        dag.at(instruction_label),"\n",
                         "Caused by:\n",
-                        application_result.maybe_error->what())};
+                        error->what())};
                 }
             }
-            else
-            {
-                res.ls_instructions_count_++;
-                instruction_visitor(instruction);
-                handle_followup_instructions(instruction_label, std::move(application_result.followup_instructions));
-            }
         }
+        failed_this_slice.clear();
+        applied_this_slice = false;
 
         // Advance the slice
-        slice_visitor(slice);
+        visit_slice(slice, slice_visitor);
         advance_slice(slice, layout);
         res.slice_count_++;
 
+        refill();
+
     }
 }
 
@@ -699,6 +779,7 @@ void run_through_dense_slices_dag(
 DensePatchComputationResult run_through_dense_slices(
         LSInstructionStream&& instruction_stream,
         bool dag_pipeline,
+        const DagPipelineOptions& dag_options,
         bool local_instructions,
         const Layout& layout,
         Router& router,
@@ -733,10 +814,9 @@ DensePatchComputationResult run_through_dense_slices(
     {
         if (dag_pipeline)
         {
-            auto dag = dag::full_dependency_dag_from_instruction_stream(instruction_stream);
             return run_through_dense_slices_dag(
-                std::move(dag),
-                instruction_stream.core_qubits(),
+                instruction_stream,
+                dag_options,
                 local_instructions,
                 layout,
                 router,
@@ -780,8 +860,33 @@ DensePatchComputationResult run_through_dense_slices(
 }
 
 
+std::ostream& operator<<(std::ostream& os, DagScheduler scheduler)
+{
+    switch (scheduler)
+    {
+        case DagScheduler::LabelOrder: return os << "label_order";
+        case DagScheduler::CriticalPath: return os << "critical_path";
+    }
+    LSTK_UNREACHABLE;
+}
+
+void DensePatchComputationResult::print_stats(std::ostream& os) const
+{
+    if (dag_scheduler_)
+    {
+        os << "Dag scheduler: " << *dag_scheduler_;
+        if (label_order_slice_count_)
+            os << ", " << slice_count_ << " slices against " << *label_order_slice_count_ << " with "
+               << DagScheduler::LabelOrder;
+        os << std::endl;
+    }
+}
+
 DensePatchComputationResult::DensePatchComputationResult(const DensePatchComputationResult& other)
- : ls_instructions_count_(other.ls_instructions_count_), slice_count_(other.slice_count_)
+ : ls_instructions_count_(other.ls_instructions_count_),
+   slice_count_(other.slice_count_),
+   dag_scheduler_(other.dag_scheduler_),
+   label_order_slice_count_(other.label_order_slice_count_)
 {}
 
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include <lsqecc/patches/dense_slice.hpp>
 
+#include <algorithm>
+
 namespace lsqecc
 {
 
@@ -12,96 +14,324 @@ const Layout& DenseSlice::get_layout() const
 }
 
 
-void DenseSlice::traverse_cells_mut(const DenseSlice::CellTraversalFunctor& f)
+namespace {
+
+void traverse_packed_cells(
+        size_t width,
+        const std::vector<PackedCell>& cells,
+        const std::vector<PatchId>& ids,
+        const DenseSlice::CellTraversalConstFunctor& f)
 {
     Cell c {0,0};
-    for(std::vector<std::optional<DensePatch>>& row: cells)
+    for(size_t i = 0; i < cells.size(); i++)
     {
-        for (std::optional<DensePatch>& patch: row)
+        f(c, cells[i].to_dense_patch(ids[i] == DenseSlice::no_patch_id ? std::nullopt : std::make_optional(ids[i])));
+        if(++c.col == static_cast<Cell::CoordinateType>(width))
         {
-            f(c,patch);
-            c.col++;
+            c.row++;
+            c.col = 0;
         }
-        c.row++;
-        c.col = 0;
     }
+}
 
 }
 
 void DenseSlice::traverse_cells(const CellTraversalConstFunctor& f) const
 {
-    const_cast<DenseSlice*>(this)->traverse_cells_mut(f);
+    traverse_packed_cells(width_, cells_, ids_, f);
 }
 
-std::optional<std::reference_wrapper<DensePatch>> DenseSlice::get_patch_by_id(PatchId id)
+DenseSliceSnapshot DenseSlice::snapshot() const
 {
-    std::optional<std::reference_wrapper<DensePatch>> ret;
-    traverse_cells_mut([&](const Cell& c, std::optional<DensePatch>& p) {
-        if(p && p->id == id)
-            ret = std::ref(*p);
-    });
-    return ret;
+    return {layout, width_, cells_, ids_, time_to_next_magic_state_by_distillation_region};
+}
+
+void DenseSliceSnapshot::traverse_cells(const DenseSlice::CellTraversalConstFunctor& f) const
+{
+    traverse_packed_cells(width, cells, ids, f);
 }
 
+SurfaceCodeTimestep DenseSliceSnapshot::time_to_next_magic_state(size_t distillation_region_id) const
+{
+    return time_to_next_magic_state_by_distillation_region[distillation_region_id];
+}
 
-std::optional<std::reference_wrapper<DensePatch const>> DenseSlice::get_patch_by_id(PatchId id) const
+std::optional<DensePatch> DenseSlice::get_patch_by_id(PatchId id) const
 {
-    auto maybe_patch = const_cast<DenseSlice*>(this)->get_patch_by_id(id);
-    return maybe_patch ? std::make_optional(std::cref(maybe_patch->get())) : std::nullopt;
+    auto cell = get_cell_by_id(id);
+    if(!cell) return std::nullopt;
+    return patch_at(*cell);
 }
 
 std::optional<SparsePatch> DenseSlice::get_sparse_patch_by_id(lsqecc::PatchId id) const
 {
-    auto dense_patch = get_patch_by_id(id);
-    if(!dense_patch) return std::nullopt;
-    const DensePatch& dense_patch_ref = dense_patch->get();
-
-    return SparsePatch{
-            {static_cast<Patch>(dense_patch_ref)},
-            SingleCellOccupiedByPatch{
-                    {dense_patch_ref.boundaries},
-                    get_cell_by_id(id).value()
-            },
-    };
+    auto cell = get_cell_by_id(id);
+    if(!cell) return std::nullopt;
+    return patch_at(*cell)->to_sparse_patch(*cell);
 }
 
 std::optional<Cell> DenseSlice::get_cell_by_id(PatchId id) const
 {
-    std::optional<Cell> ret;
-    traverse_cells([&](const Cell& c, const std::optional<DensePatch>& p) {
-        if(p && p->id == id)
-            ret = c;
-    });
-    return ret;
+    auto it = patch_id_index_.find(id);
+    if(it == patch_id_index_.end()) return std::nullopt;
+    return it->second;
 }
 
-std::optional<DensePatch>& DenseSlice::patch_at(const Cell& cell)
+std::optional<DensePatch> DenseSlice::patch_at(const Cell& cell) const
 {
-    return cells.at(cell.row).at(cell.col);
+    const size_t i = checked_index_of(cell);
+    return cells_[i].to_dense_patch(ids_[i] == no_patch_id ? std::nullopt : std::make_optional(ids_[i]));
 }
 
-const std::optional<DensePatch>& DenseSlice::patch_at(const Cell& cell) const
+const PackedCell& DenseSlice::packed_cell_at(const Cell& cell) const
 {
-    return const_cast<DenseSlice*>(this)->patch_at(cell);
+    return cells_[checked_index_of(cell)];
+}
+
+const std::vector<PackedCell>& DenseSlice::packed_cells() const
+{
+    return cells_;
+}
+
+bool DenseSlice::is_within_slice(const Cell& cell) const
+{
+    return cell.row >= 0 && cell.col >= 0
+           && static_cast<size_t>(cell.col) < width_
+           && index_of(cell) < cells_.size();
+}
+
+size_t DenseSlice::checked_index_of(const Cell& cell) const
+{
+    if(!is_within_slice(cell))
+        throw std::out_of_range(lstk::cat("Cell ", cell, " is outside of the slice"));
+    return index_of(cell);
+}
+
+PackedCell& DenseSlice::occupied_packed_cell_at(const Cell& cell)
+{
+    PackedCell& packed = cells_[checked_index_of(cell)];
+    if(!packed.is_occupied())
+        throw std::logic_error(lstk::cat("No patch at ", cell));
+    return packed;
 }
 
 void DenseSlice::delete_patch_by_id(PatchId id)
 {
-    traverse_cells_mut([&](const Cell& c, std::optional<DensePatch>& p) {
-        if(p && p->id == id) p = std::nullopt;
+    auto cell = get_cell_by_id(id);
+    if(cell) clear_cell(*cell);
+}
+
+void DenseSlice::index_patch_id(const Cell& cell)
+{
+    const PatchId id = ids_[index_of(cell)];
+    if(id != no_patch_id) patch_id_index_.insert_or_assign(id, cell);
+}
+
+void DenseSlice::unindex_patch_id(const Cell& cell)
+{
+    const PatchId id = ids_[index_of(cell)];
+    if(id == no_patch_id) return;
+
+    // Only drop the entry if it refers to this cell, the id might have been rebound elsewhere already (e.g. by a Move)
+    auto it = patch_id_index_.find(id);
+    if(it != patch_id_index_.end() && it->second == cell)
+        patch_id_index_.erase(it);
+}
+
+void DenseSlice::set_patch_id(const Cell& cell, std::optional<PatchId> id)
+{
+    if(!cells_[checked_index_of(cell)].is_occupied())
+        throw std::logic_error(lstk::cat("Cannot set the id of the empty cell ", cell));
+    if(id == no_patch_id)
+        throw std::logic_error(lstk::cat("Patch id ", *id, " is reserved"));
+    unindex_patch_id(cell);
+    ids_[index_of(cell)] = id.value_or(no_patch_id);
+    index_patch_id(cell);
+    mark_changed(index_of(cell));
+}
+
+void DenseSlice::set_patch(const Cell& cell, const DensePatch& patch)
+{
+    checked_index_of(cell);
+    if(patch.id == no_patch_id)
+        throw std::logic_error(lstk::cat("Patch id ", *patch.id, " is reserved"));
+    unindex_patch_id(cell);
+    const uint16_t previous_routing_state = cells_[index_of(cell)].routing_state();
+    cells_[index_of(cell)] = PackedCell::from_dense_patch(patch);
+    ids_[index_of(cell)] = patch.id.value_or(no_patch_id);
+    free_cells_.set(cell, false);
+    bump_region_if_changed(cell, previous_routing_state);
+    index_patch_id(cell);
+    mark_dirty_if_transient(index_of(cell));
+    mark_changed(index_of(cell));
+}
+
+void DenseSlice::clear_cell(const Cell& cell)
+{
+    checked_index_of(cell);
+    unindex_patch_id(cell);
+    const uint16_t previous_routing_state = cells_[index_of(cell)].routing_state();
+    cells_[index_of(cell)] = PackedCell{};
+    ids_[index_of(cell)] = no_patch_id;
+    free_cells_.set(cell, true);
+    bump_region_if_changed(cell, previous_routing_state);
+    mark_changed(index_of(cell));
+}
+
+void DenseSlice::set_patch_activity(const Cell& cell, PatchActivity activity)
+{
+    occupied_packed_cell_at(cell).set_activity(activity);
+    mark_dirty_if_transient(index_of(cell));
+    mark_changed(index_of(cell));
+}
+
+void DenseSlice::set_patch_boundaries(const Cell& cell, const CellBoundaries& boundaries)
+{
+    PackedCell& packed = occupied_packed_cell_at(cell);
+    const uint16_t previous_routing_state = packed.routing_state();
+    packed.set_boundary(CellSide::Top, boundaries.top);
+    packed.set_boundary(CellSide::Bottom, boundaries.bottom);
+    packed.set_boundary(CellSide::Left, boundaries.left);
+    packed.set_boundary(CellSide::Right, boundaries.right);
+    bump_region_if_changed(cell, previous_routing_state);
+    mark_dirty_if_transient(index_of(cell));
+    mark_changed(index_of(cell));
+}
+
+void DenseSlice::bump_region_if_changed(const Cell& cell, uint16_t previous_routing_state)
+{
+    if(cells_[index_of(cell)].routing_state() != previous_routing_state)
+        region_versions_.bump(cell);
+}
+
+namespace {
+
+std::optional<CellSide> side_facing(const Cell& target, const Cell& neighbour)
+{
+    if(neighbour == Cell{target.row-1, target.col})   return CellSide::Top;
+    if(neighbour == Cell{target.row+1, target.col})   return CellSide::Bottom;
+    if(neighbour == Cell{target.row,   target.col-1}) return CellSide::Left;
+    if(neighbour == Cell{target.row,   target.col+1}) return CellSide::Right;
+    return std::nullopt;
+}
+
+}
+
+void DenseSlice::activate_boundary_between(const Cell& target, const Cell& neighbour)
+{
+    auto side = side_facing(target, neighbour);
+    if(!side || !cells_[checked_index_of(target)].is_occupied())
+        throw std::logic_error(lstk::cat("No boundary between cells ", target, "and ", neighbour));
+    cells_[index_of(target)].set_boundary_active(*side, true);
+    mark_dirty_if_transient(index_of(target));
+    mark_changed(index_of(target));
+}
+
+void DenseSlice::mark_dirty_if_transient(size_t index)
+{
+    const PackedCell& packed = cells_[index];
+    const bool is_transient = packed.type() == PatchType::Routing
+            || packed.activity() == PatchActivity::Measurement
+            || packed.activity() == PatchActivity::Unitary
+            || packed.has_active_boundary();
+    if(is_transient && !is_dirty_[index])
+    {
+        is_dirty_[index] = true;
+        dirty_cells_.push_back(index);
+    }
+}
+
+void DenseSlice::mark_changed(size_t index)
+{
+    if(!is_changed_[index])
+    {
+        is_changed_[index] = true;
+        changed_cells_.push_back(index);
+    }
+}
+
+void DenseSlice::clear_changed_cells()
+{
+    for(size_t index : changed_cells_)
+        is_changed_[index] = false;
+    changed_cells_.clear();
+}
+
+void DenseSlice::clear_transient_state_at(size_t index)
+{
+    PackedCell& packed = cells_[index];
+    if(!packed.is_occupied()) return;
+
+    if(packed.type() == PatchType::Routing || packed.activity() == PatchActivity::Measurement)
+    {
+        clear_cell(Cell::from_ints(index / width_, index % width_));
+        return;
+    }
+
+    if(packed.activity() == PatchActivity::Unitary)
+        packed.set_activity(PatchActivity::None);
+    packed.clear_boundary_activity();
+    mark_changed(index);
+}
+
+void DenseSlice::clear_transient_patches()
+{
+    for(size_t index : dirty_cells_)
+    {
+        clear_transient_state_at(index);
+        is_dirty_[index] = false;
+    }
+    dirty_cells_.clear();
+}
+
+void DenseSlice::clear_transient_patches_full_sweep()
+{
+    for(size_t index = 0; index < cells_.size(); index++)
+        clear_transient_state_at(index);
+    std::fill(is_dirty_.begin(), is_dirty_.end(), false);
+    dirty_cells_.clear();
+}
+
+void DenseSlice::verify_no_transient_state() const
+{
+    traverse_cells([&](const Cell& c, const std::optional<DensePatch>& p) {
+        if(p && (p->type == PatchType::Routing
+                  || p->activity == PatchActivity::Measurement
+                  || p->activity == PatchActivity::Unitary
+                  || p->boundaries.has_active_boundary()))
+            throw std::logic_error(lstk::cat("Transient state left at ", c, " after the slice was advanced"));
     });
 }
 
+void DenseSlice::verify_patch_id_index() const
+{
+    size_t bound_patches = 0;
+    traverse_cells([&](const Cell& c, const std::optional<DensePatch>& p) {
+        if(!p || !p->id) return;
+        bound_patches++;
+        auto indexed_cell = get_cell_by_id(*p->id);
+        if(!indexed_cell || *indexed_cell != c)
+            throw std::logic_error(lstk::cat("Patch id index out of sync: patch ", *p->id, " found at ", c));
+    });
+    if(bound_patches != patch_id_index_.size())
+        throw std::logic_error(lstk::cat("Patch id index out of sync: ", patch_id_index_.size(),
+                                         " indexed ids, ", bound_patches, " bound patches on the lattice"));
+}
+
 std::vector<Cell> DenseSlice::get_neigbours_within_slice(const Cell& cell) const
 {
     return cell.get_neigbours_within_bounding_box_inclusive({0,0}, get_layout().furthest_cell());
 }
 
 DenseSlice::DenseSlice(const Layout& layout)
-: cells(std::vector<RowStore>(
-        layout.furthest_cell().row+1,
-        RowStore(layout.furthest_cell().col+1, std::nullopt))),
-  layout(std::cref(layout))
+: layout(std::cref(layout)),
+  width_(static_cast<size_t>(layout.furthest_cell().col+1)),
+  cells_(width_*static_cast<size_t>(layout.furthest_cell().row+1)),
+  ids_(cells_.size(), no_patch_id),
+  free_cells_(static_cast<size_t>(layout.furthest_cell().row+1), width_, true),
+  region_versions_(layout.furthest_cell()),
+  is_dirty_(cells_.size(), false),
+  is_changed_(cells_.size(), false)
 {
 }
 
@@ -116,7 +346,7 @@ DenseSlice::DenseSlice(const lsqecc::Layout &layout, const tsl::ordered_set<Patc
     {
         if(core_qubit_ids_itr == core_qubit_ids.end()) break;
         Cell cell = place_sparse_patch(p,false);
-        patch_at(cell)->id = *core_qubit_ids_itr++;
+        set_patch_id(cell, *core_qubit_ids_itr++);
     }
 
     for (const Cell& cell: layout.predistilled_y_states())
@@ -129,27 +359,27 @@ DenseSlice::DenseSlice(const lsqecc::Layout &layout, const tsl::ordered_set<Patc
     {
         for (const SingleCellOccupiedByPatch& cell: distillation_region.sub_cells)
         {
-            patch_at(cell.cell) = DensePatch{
+            set_patch(cell.cell, DensePatch{
                     Patch{PatchType::Distillation,PatchActivity::Distillation,std::nullopt},
-                    static_cast<CellBoundaries>(cell)};
+                    static_cast<CellBoundaries>(cell)});
         }
     }
 
     for(const Cell& cell: layout.dead_location())
     {
-        patch_at(cell) = DensePatch{
+        set_patch(cell, DensePatch{
             Patch{PatchType::Dead,PatchActivity::Dead,std::nullopt},
             CellBoundaries{Boundary{BoundaryType::Connected, false},Boundary{BoundaryType::Connected, false},
-                Boundary{BoundaryType::Connected, false},Boundary{BoundaryType::Connected, false}}};
+                Boundary{BoundaryType::Connected, false},Boundary{BoundaryType::Connected, false}}});
     }
 
     if (layout.magic_states_reserved()) {
         for (unsigned int i=0; i<layout.distillation_regions().size(); i++) {
             for (const Cell& cell: layout.distilled_state_locations(i)) {
-                patch_at(cell) = DensePatch{
+                set_patch(cell, DensePatch{
                     Patch{PatchType::Distillation,PatchActivity::Distillation,std::nullopt},
                     CellBoundaries{Boundary{BoundaryType::Connected, false},Boundary{BoundaryType::Connected, false},
-                        Boundary{BoundaryType::Connected, false},Boundary{BoundaryType::Connected, false}}};
+                        Boundary{BoundaryType::Connected, false},Boundary{BoundaryType::Connected, false}}});
             }
         }
     }
@@ -161,7 +391,7 @@ DenseSlice::DenseSlice(const lsqecc::Layout &layout, const tsl::ordered_set<Patc
 
 bool DenseSlice::is_cell_free(const Cell& cell) const
 {
-    return !patch_at(cell).has_value();
+    return !cells_[checked_index_of(cell)].is_occupied();
 }
 
 Cell DenseSlice::place_sparse_patch(const SparsePatch& sparse_patch, bool distillation)
@@ -175,7 +405,7 @@ Cell DenseSlice::place_sparse_patch(const SparsePatch& sparse_patch, bool distil
                     "Found patch: ", patch_at(occupied_cell->cell)->id.value_or(-1)));
     }
 
-    patch_at(occupied_cell->cell) = DensePatch::from_sparse_patch(sparse_patch);
+    set_patch(occupied_cell->cell, DensePatch::from_sparse_patch(sparse_patch));
     return occupied_cell->cell;
 }
 void DenseSlice::place_sparse_patch_multiple_cells(const SparsePatch& sparse_patch){
@@ -195,7 +425,7 @@ void DenseSlice::place_sparse_patch_multiple_cells(const SparsePatch& sparse_pat
                             .right={BoundaryType::Smooth,false}},
                             patch.cell
                     }};
-                patch_at(patch.cell) = DensePatch::from_sparse_patch(a);
+                set_patch(patch.cell, DensePatch::from_sparse_patch(a));
             }
             else {
                 throw std::logic_error(lstk::cat("Double patch occupation at ", patch.cell, "\n",
@@ -207,46 +437,36 @@ void DenseSlice::place_sparse_patch_multiple_cells(const SparsePatch& sparse_pat
 
 bool DenseSlice::has_patch(PatchId id) const
 {
-    return (bool) get_patch_by_id(id);
+    return patch_id_index_.contains(id);
 }
 
-std::optional<std::reference_wrapper<Boundary>> DenseSlice::get_boundary_between(
-        const Cell& target, const Cell& neighbour)
+std::optional<Boundary> DenseSlice::get_boundary_between(const Cell& target, const Cell& neighbour) const
 {
-    auto& target_patch = patch_at(target);
-    if(!target_patch) return std::nullopt;
-
-    if(neighbour == Cell{target.row-1, target.col})   return target_patch->boundaries.top;
-    if(neighbour == Cell{target.row+1, target.col})   return target_patch->boundaries.bottom;
-    if(neighbour == Cell{target.row,   target.col-1}) return target_patch->boundaries.left;
-    if(neighbour == Cell{target.row,   target.col+1}) return target_patch->boundaries.right;
-
-    return std::nullopt;
+    const PackedCell& target_patch = cells_[index_of(target)];
+    if(!target_patch.is_occupied()) return std::nullopt;
 
+    auto side = side_facing(target, neighbour);
+    if(!side) return std::nullopt;
+    return target_patch.boundary(*side);
 }
 
-std::reference_wrapper<Boundary> DenseSlice::get_boundary_between_or_fail(const Cell& target, const Cell& neighbour)
+bool DenseSlice::have_boundary_of_type_with(const Cell& target, const Cell& neighbour, PauliOperator op) const
 {
-    return lstk::get_or_throw(get_boundary_between(target, neighbour), 
-        std::logic_error{lstk::cat("No boundary between cells ", target, "and ", neighbour)});
+    const auto b = get_boundary_between(target, neighbour);
+    return b ? b->boundary_type== boundary_for_operator(op) : false;
 }
 
 
-std::optional<std::reference_wrapper<const Boundary>> DenseSlice::get_boundary_between(
-        const Cell& target, const Cell& neighbour) const
+const CellBitboard* DenseSlice::free_cell_bitboard() const
 {
-    std::optional<std::reference_wrapper<Boundary>> r
-        = const_cast<DenseSlice*>(this)->get_boundary_between(target,neighbour);
-    return r ? std::make_optional(std::cref(r->get())) : std::nullopt;
+    return &free_cells_;
 }
 
-bool DenseSlice::have_boundary_of_type_with(const Cell& target, const Cell& neighbour, PauliOperator op) const
+const RegionVersions* DenseSlice::region_versions() const
 {
-    const auto b = get_boundary_between(target, neighbour);
-    return b ? b->get().boundary_type== boundary_for_operator(op) : false;
+    return &region_versions_;
 }
 
-
 SurfaceCodeTimestep DenseSlice::time_to_next_magic_state(size_t distillation_region_id) const
 {
     return time_to_next_magic_state_by_distillation_region[distillation_region_id];
@@ -0,0 +1,441 @@
+#include <lsqecc/patches/slice_binary.hpp>
+
+#include <lstk/lstk.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace lsqecc {
+
+
+namespace {
+
+constexpr char magic[] = {'L', 'S', 'Q', 'S', 'L', 'I', 'C', 'E'};
+
+// Ids are shifted by one so that 0 can stand for no id
+constexpr uint32_t no_id_code = 0;
+
+template<typename T>
+void append_fixed(std::string& out, T value)
+{
+    for(size_t byte = 0; byte < sizeof(T); byte++)
+        out += static_cast<char>((value >> (8*byte)) & 0xff);
+}
+
+void append_u32(std::string& out, uint32_t value) {append_fixed(out, value);}
+void append_u64(std::string& out, uint64_t value) {append_fixed(out, value);}
+
+void append_varint(std::string& out, uint64_t value)
+{
+    while(value >= 0x80)
+    {
+        out += static_cast<char>((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+}
+
+
+SliceBinaryWriter::SliceBinaryWriter(
+        std::ostream& os,
+        const Layout& layout,
+        bool delta_encode,
+        size_t keyframe_interval)
+    : os_(os), delta_encode_(delta_encode), keyframe_interval_(keyframe_interval)
+{
+    const Cell furthest_cell = layout.furthest_cell();
+    const auto rows = static_cast<uint32_t>(furthest_cell.row+1);
+    const auto cols = static_cast<uint32_t>(furthest_cell.col+1);
+    num_cells_ = static_cast<size_t>(rows)*cols;
+
+    std::string header{magic, sizeof(magic)};
+    append_u32(header, version);
+    append_u32(header, rows);
+    append_u32(header, cols);
+    const std::vector<uint32_t> timer_cells = distillation_timer_cells(layout);
+    append_u32(header, static_cast<uint32_t>(timer_cells.size()));
+    for(uint32_t cell: timer_cells)
+        append_u32(header, cell);
+    write_bytes(header);
+}
+
+void SliceBinaryWriter::write(const DenseSlice& slice)
+{
+    if(slice.packed_cells().size() != num_cells_)
+        throw std::logic_error("SliceBinaryWriter: slice is not on the layout of the writer");
+
+    const bool keyframe_due = keyframes_.empty()
+            || (keyframe_interval_ != 0 && slices_written_ - keyframes_.back().first >= keyframe_interval_);
+    if(keyframe_due)
+        write_keyframe(slice);
+    else if(delta_encode_)
+        write_delta(slice);
+    else
+        write_full(slice, SliceRecordKind::Full);
+    slices_written_++;
+}
+
+void SliceBinaryWriter::finish()
+{
+    const uint64_t end_offset = bytes_written_;
+    record_buffer_.clear();
+    record_buffer_ += static_cast<char>(SliceRecordKind::End);
+    append_u64(record_buffer_, slices_written_);
+    append_u64(record_buffer_, keyframes_.size());
+    std::pair<uint64_t, uint64_t> previous_keyframe{0, 0};
+    for(const auto& keyframe: keyframes_)
+    {
+        append_varint(record_buffer_, keyframe.first - previous_keyframe.first);
+        append_varint(record_buffer_, keyframe.second - previous_keyframe.second);
+        previous_keyframe = keyframe;
+    }
+    append_u64(record_buffer_, end_offset);
+    write_bytes(record_buffer_);
+    os_.flush();
+}
+
+void SliceBinaryWriter::write_bytes(const std::string& bytes)
+{
+    os_.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    bytes_written_ += bytes.size();
+}
+
+uint32_t SliceBinaryWriter::palette_index(const PackedCell& cell)
+{
+    auto [it, inserted] = palette_.try_emplace(cell.bits(), static_cast<uint32_t>(palette_.size()));
+    if(inserted)
+        palette_additions_.push_back(cell.bits());
+    return it->second;
+}
+
+void SliceBinaryWriter::write_cell(const PackedCell& cell, PatchId id)
+{
+    append_varint(cells_buffer_, palette_index(cell));
+    if(cell.is_occupied())
+        append_varint(cells_buffer_, id == DenseSlice::no_patch_id ? no_id_code : id+1);
+}
+
+void SliceBinaryWriter::write_keyframe(const DenseSlice& slice)
+{
+    // The palette starts over, so that readers can start here
+    palette_.clear();
+    palette_additions_.clear();
+    palette_.emplace(PackedCell{}.bits(), 0);
+    keyframes_.emplace_back(slices_written_, bytes_written_);
+    write_full(slice, SliceRecordKind::Keyframe);
+}
+
+void SliceBinaryWriter::write_full(const DenseSlice& slice, SliceRecordKind kind)
+{
+    const auto& cells = slice.packed_cells();
+    const auto& ids = slice.patch_ids();
+    for(size_t i = 0; i < cells.size(); i++)
+        write_cell(cells[i], ids[i]);
+    if(delta_encode_)
+    {
+        previous_cells_ = cells;
+        previous_ids_ = ids;
+    }
+    write_record(kind, slice);
+}
+
+void SliceBinaryWriter::write_delta(const DenseSlice& slice)
+{
+    // Past this a keyframe is smaller
+    if(slice.changed_cells().size() > num_cells_/2)
+    {
+        write_keyframe(slice);
+        return;
+    }
+
+    // Cells can be touched and then changed back. The id of an empty cell isn't written, so it doesn't count
+    const auto& cells = slice.packed_cells();
+    const auto& ids = slice.patch_ids();
+    changed_cells_.clear();
+    for(size_t i: slice.changed_cells())
+        if(cells[i] != previous_cells_[i] || (cells[i].is_occupied() && ids[i] != previous_ids_[i]))
+            changed_cells_.push_back(i);
+    std::sort(changed_cells_.begin(), changed_cells_.end());
+
+    append_varint(cells_buffer_, changed_cells_.size());
+    size_t next_index = 0;
+    for(size_t i: changed_cells_)
+    {
+        append_varint(cells_buffer_, i - next_index);
+        write_cell(cells[i], ids[i]);
+        previous_cells_[i] = cells[i];
+        previous_ids_[i] = ids[i];
+        next_index = i+1;
+    }
+    write_record(SliceRecordKind::Delta, slice);
+}
+
+void SliceBinaryWriter::write_record(SliceRecordKind kind, const DenseSlice& slice)
+{
+    record_buffer_.clear();
+    record_buffer_ += static_cast<char>(kind);
+
+    append_varint(record_buffer_, palette_additions_.size());
+    for(uint32_t bits: palette_additions_)
+        for(size_t byte = 0; byte < 3; byte++)
+            record_buffer_ += static_cast<char>((bits >> (8*byte)) & 0xff);
+    palette_additions_.clear();
+
+    const DistillationTimeMap& timers = slice.time_to_next_magic_state_by_distillation_region;
+    append_varint(record_buffer_, timers.size());
+    for(SurfaceCodeTimestep timer: timers)
+        append_varint(record_buffer_, timer);
+
+    record_buffer_ += cells_buffer_;
+    cells_buffer_.clear();
+    write_bytes(record_buffer_);
+}
+
+
+SliceBinaryReader::SliceBinaryReader(std::istream& is)
+    : in_(*is.rdbuf()), start_(in_.pubseekoff(0, std::ios::cur, std::ios::in))
+{
+    char file_magic[sizeof(magic)];
+    if(in_.sgetn(file_magic, sizeof(magic)) != sizeof(magic) || std::memcmp(file_magic, magic, sizeof(magic)) != 0)
+        throw std::runtime_error("Not a binary slice file");
+    const uint32_t file_version = read_u32();
+    if(file_version != SliceBinaryWriter::version)
+        throw std::runtime_error(lstk::cat("Unsupported binary slice file version ", file_version));
+
+    rows_ = read_u32();
+    cols_ = read_u32();
+    const size_t num_cells = rows_*cols_;
+    if(num_cells > std::numeric_limits<uint32_t>::max())
+        throw std::runtime_error(lstk::cat("Binary slice file has too many cells: ", rows_, "x", cols_));
+
+    const uint32_t num_timer_cells = read_u32();
+    for(uint32_t region = 0; region < num_timer_cells; region++)
+    {
+        timer_cells_.push_back(read_u32());
+        if(timer_cells_.back() >= num_cells)
+            throw std::runtime_error(lstk::cat("Timer cell ", timer_cells_.back(), " is outside the slice"));
+    }
+
+    cells_.resize(num_cells);
+    ids_.resize(num_cells, DenseSlice::no_patch_id);
+}
+
+bool SliceBinaryReader::read_next()
+{
+    if(at_end_) return false;
+
+    const auto kind = static_cast<SliceRecordKind>(read_byte());
+    if(kind == SliceRecordKind::End)
+    {
+        at_end_ = true;
+        return false;
+    }
+    if(kind != SliceRecordKind::Keyframe && kind != SliceRecordKind::Full && kind != SliceRecordKind::Delta)
+        throw std::runtime_error(lstk::cat("Unknown slice record kind ", static_cast<int>(kind)));
+    if(kind != SliceRecordKind::Keyframe && slices_read_ == 0)
+        throw std::runtime_error("Binary slice file doesn't start with a keyframe");
+
+    if(kind == SliceRecordKind::Keyframe)
+        palette_.assign(1, PackedCell{});
+    read_palette_additions();
+
+    timers_.resize(read_varint());
+    for(SurfaceCodeTimestep& timer: timers_)
+        timer = read_varint();
+    if(timers_.size() < timer_cells_.size())
+        throw std::runtime_error("Binary slice file has fewer timers than distillation regions");
+
+    if(kind != SliceRecordKind::Delta)
+    {
+        for(size_t i = 0; i < cells_.size(); i++)
+            read_cell(i);
+    }
+    else
+    {
+        const uint32_t num_changed = read_varint();
+        size_t index = 0;
+        for(uint32_t change = 0; change < num_changed; change++)
+        {
+            index += read_varint();
+            if(index >= cells_.size())
+                throw std::runtime_error(lstk::cat("Changed cell ", index, " is outside the slice"));
+            read_cell(index++);
+        }
+    }
+
+    slices_read_++;
+    return true;
+}
+
+uint8_t SliceBinaryReader::read_byte()
+{
+    const auto byte = in_.sbumpc();
+    if(byte == std::streambuf::traits_type::eof())
+        throw std::runtime_error("Binary slice file ends before its end record");
+    return static_cast<uint8_t>(byte);
+}
+
+uint32_t SliceBinaryReader::read_u32()
+{
+    uint32_t value = 0;
+    for(size_t byte = 0; byte < 4; byte++)
+        value |= static_cast<uint32_t>(read_byte()) << (8*byte);
+    return value;
+}
+
+uint64_t SliceBinaryReader::read_u64()
+{
+    const uint64_t low = read_u32();
+    return low | static_cast<uint64_t>(read_u32()) << 32;
+}
+
+uint32_t SliceBinaryReader::read_varint()
+{
+    const uint64_t value = read_varint64();
+    if(value > std::numeric_limits<uint32_t>::max())
+        throw std::runtime_error(lstk::cat("Varint too large in binary slice file: ", value));
+    return static_cast<uint32_t>(value);
+}
+
+uint64_t SliceBinaryReader::read_varint64()
+{
+    uint64_t value = 0;
+    for(size_t shift = 0; shift < 64; shift += 7)
+    {
+        const uint8_t byte = read_byte();
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if(!(byte & 0x80))
+            return value;
+    }
+    throw std::runtime_error("Varint too long in binary slice file");
+}
+
+void SliceBinaryReader::read_palette_additions()
+{
+    const uint32_t num_additions = read_varint();
+    for(uint32_t addition = 0; addition < num_additions; addition++)
+    {
+        uint32_t bits = 0;
+        for(size_t byte = 0; byte < 3; byte++)
+            bits |= static_cast<uint32_t>(read_byte()) << (8*byte);
+        try
+        {
+            palette_.push_back(PackedCell::from_bits(bits));
+        }
+        catch (const std::invalid_argument& e)
+        {
+            throw std::runtime_error(e.what());
+        }
+    }
+}
+
+void SliceBinaryReader::read_cell(size_t index)
+{
+    const uint32_t palette_index = read_varint();
+    if(palette_index >= palette_.size())
+        throw std::runtime_error(lstk::cat("Cell state ", palette_index, " is not in the palette"));
+    cells_[index] = palette_[palette_index];
+
+    const uint32_t id_code = cells_[index].is_occupied() ? read_varint() : no_id_code;
+    ids_[index] = id_code == no_id_code ? DenseSlice::no_patch_id : id_code-1;
+}
+
+
+size_t SliceBinaryReader::num_slices()
+{
+    read_index();
+    return *num_slices_;
+}
+
+void SliceBinaryReader::seek(size_t slice)
+{
+    read_index();
+    if(slice >= *num_slices_)
+        throw std::out_of_range(lstk::cat("No slice ", slice, " in a binary slice file with ", *num_slices_));
+
+    auto keyframe = std::upper_bound(keyframes_.begin(), keyframes_.end(), std::make_pair(uint64_t{slice}, UINT64_MAX));
+    if(keyframe == keyframes_.begin())
+        throw std::runtime_error("Binary slice file has no keyframe at its start");
+    keyframe--;
+
+    seek_to_offset(keyframe->second);
+    at_end_ = false;
+    slices_read_ = keyframe->first;
+    while(slices_read_ <= slice)
+        if(!read_next())
+            throw std::runtime_error(lstk::cat("Binary slice file ends before slice ", slice));
+}
+
+void SliceBinaryReader::read_index()
+{
+    if(num_slices_) return;
+
+    // The offset of the End record is in the last 8 bytes
+    const std::streampos end = in_.pubseekoff(-8, std::ios::end, std::ios::in);
+    if(end == std::streampos(-1) || start_ == std::streampos(-1))
+        throw std::runtime_error("Seeking in binary slices needs a stream that can seek");
+    const uint64_t end_offset = read_u64();
+
+    seek_to_offset(end_offset);
+    if(static_cast<SliceRecordKind>(read_byte()) != SliceRecordKind::End)
+        throw std::runtime_error("Binary slice file has no End record where its last bytes say");
+    const uint64_t num_slices = read_u64();
+    const uint64_t num_keyframes = read_u64();
+    std::vector<std::pair<uint64_t, uint64_t>> keyframes;
+    std::pair<uint64_t, uint64_t> keyframe{0, 0};
+    for(uint64_t i = 0; i < num_keyframes; i++)
+    {
+        keyframe.first += read_varint64();
+        keyframe.second += read_varint64();
+        keyframes.push_back(keyframe);
+    }
+
+    keyframes_ = std::move(keyframes);
+    num_slices_ = num_slices;
+    // Where read_next would have continued is lost, it ends here until the next seek
+    at_end_ = true;
+}
+
+void SliceBinaryReader::seek_to_offset(uint64_t offset)
+{
+    const auto position = start_ + static_cast<std::streamoff>(offset);
+    if(in_.pubseekpos(position, std::ios::in) != position)
+        throw std::runtime_error(lstk::cat("Cannot seek to offset ", offset, " of binary slice file"));
+}
+
+
+void binary_slices_to_json(std::istream& is, std::ostream& os, JsonStyle style, size_t first_slice, size_t max_slices)
+{
+    SliceBinaryReader reader{is};
+    SliceJsonFormatter formatter{style};
+    std::string buffer;
+    // Same framing as SliceJsonWriter
+    size_t slices_written = 0;
+    auto write_slice = [&](){
+        buffer.clear();
+        formatter.append(buffer, reader.cols(), reader.timer_cells(), reader.cells(), reader.ids(),
+                         reader.time_to_next_magic_state_by_distillation_region());
+        os << (slices_written++ == 0 ? "[\n" : ",\n") << buffer;
+    };
+
+    if(first_slice != 0)
+    {
+        if(first_slice >= reader.num_slices())
+            max_slices = 0;
+        else if(max_slices != 0)
+        {
+            reader.seek(first_slice);
+            write_slice();
+        }
+    }
+    while(slices_written < max_slices && reader.read_next())
+        write_slice();
+    os << "]" << std::endl;
+}
+
+
+} // namespace lsqecc
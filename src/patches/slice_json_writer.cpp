@@ -0,0 +1,144 @@
+#include <lsqecc/patches/slice_json_writer.hpp>
+
+#include <system_error>
+
+namespace lsqecc {
+
+
+SliceJsonWriter::SliceJsonWriter(std::ostream& os, size_t num_workers, JsonStyle style, size_t queue_capacity)
+    : os_(os), formatter_(style)
+{
+    try
+    {
+        start_threads(num_workers, style, queue_capacity);
+    }
+    catch (const std::system_error&)
+    {
+        // No threads on this platform, write slices inline
+        join();
+        workers_.clear();
+    }
+}
+
+SliceJsonWriter::~SliceJsonWriter()
+{
+    join();
+}
+
+void SliceJsonWriter::start_threads(size_t num_workers, JsonStyle style, size_t queue_capacity)
+{
+    for(size_t i = 0; i < num_workers; i++)
+        workers_.push_back(std::make_unique<Worker>(style, queue_capacity));
+    for(auto& worker: workers_)
+        worker->thread = std::thread{[this, &worker = *worker](){format(worker);}};
+    if(workers_.size() > 1)
+        writer_ = std::thread{[this](){collect();}};
+}
+
+void SliceJsonWriter::write(const DenseSlice& slice)
+{
+    if(workers_.empty())
+    {
+        buffer_.clear();
+        formatter_.append(buffer_, slice);
+        write_formatted(buffer_);
+        return;
+    }
+
+    Worker& worker = *workers_[next_worker_];
+    next_worker_ = (next_worker_ + 1) % workers_.size();
+    if(!worker.snapshots.push(slice.snapshot()))
+        rethrow_error();
+}
+
+void SliceJsonWriter::finish()
+{
+    join();
+    rethrow_error();
+    os_ << "]" << std::endl;
+}
+
+void SliceJsonWriter::format(Worker& worker)
+{
+    try
+    {
+        std::string buffer;
+        while(auto snapshot = worker.snapshots.pop())
+        {
+            if(workers_.size() == 1)
+            {
+                buffer.clear();
+                worker.formatter.append(buffer, *snapshot);
+                write_formatted(buffer);
+                continue;
+            }
+            std::string formatted_slice;
+            worker.formatter.append(formatted_slice, *snapshot);
+            if(!worker.formatted_slices.push(std::move(formatted_slice)))
+                break;
+        }
+    }
+    catch (...)
+    {
+        fail(std::current_exception());
+    }
+    worker.formatted_slices.close();
+}
+
+void SliceJsonWriter::collect()
+{
+    try
+    {
+        // Slices were dealt in turn, so the worker of the next slice is known. Once it has no more, neither has any other
+        for(size_t slice = 0; ; slice++)
+        {
+            auto formatted_slice = workers_[slice % workers_.size()]->formatted_slices.pop();
+            if(!formatted_slice) break;
+            write_formatted(*formatted_slice);
+        }
+    }
+    catch (...)
+    {
+        fail(std::current_exception());
+    }
+}
+
+void SliceJsonWriter::write_formatted(const std::string& formatted_slice)
+{
+    os_ << (is_first_slice_ ? "[\n" : ",\n") << formatted_slice;
+    is_first_slice_ = false;
+}
+
+void SliceJsonWriter::join()
+{
+    for(auto& worker: workers_)
+        worker->snapshots.close();
+    for(auto& worker: workers_)
+        if(worker->thread.joinable())
+            worker->thread.join();
+    if(writer_.joinable())
+        writer_.join();
+}
+
+void SliceJsonWriter::fail(std::exception_ptr error)
+{
+    {
+        std::lock_guard lock{error_mutex_};
+        if(!error_) error_ = error;
+    }
+    for(auto& worker: workers_)
+    {
+        worker->snapshots.cancel();
+        worker->formatted_slices.cancel();
+    }
+}
+
+void SliceJsonWriter::rethrow_error()
+{
+    std::lock_guard lock{error_mutex_};
+    if(error_)
+        std::rethrow_exception(error_);
+}
+
+
+} // namespace lsqecc
@@ -38,17 +38,14 @@ VolumeCounts compute_volume_counts(const DenseSlice& slice)
 {
     VolumeCounts counts;
     counts.volume = (slice.layout.get().furthest_cell().row+1) * (slice.layout.get().furthest_cell().col+1);
-    for (const auto& row : slice.cells) 
+    for (const PackedCell& cell : slice.packed_cells())
     {
-        for (const auto& cell : row)
-        {
-            if (!cell.has_value())
-                counts.unused_routing_volume += 1;
-            else if (cell->type == PatchType::Distillation)
-                counts.distillation_volume += 1;
-            else if (cell->type == PatchType::Dead)
-                counts.dead += 1;
-        }
+        if (!cell.is_occupied())
+            counts.unused_routing_volume += 1;
+        else if (cell.type() == PatchType::Distillation)
+            counts.distillation_volume += 1;
+        else if (cell.type() == PatchType::Dead)
+            counts.dead += 1;
     }
     return counts;
 }
@@ -6,7 +6,74 @@ using namespace nlohmann;
 namespace lsqecc {
 
 
-json init_blank_json_slice(const Slice& slice)
+// Names used by the latticesurgery.com schema, shared by the nlohmann::json and the streamed output
+
+const char* boundary_name(Boundary boundary)
+{
+    switch (boundary.boundary_type)
+    {
+    case BoundaryType::None:return "None";
+    case BoundaryType::Connected: return boundary.is_active ? "AncillaJoin": "None";
+    case BoundaryType::Rough:return boundary.is_active ? "DashedStiched": "Dashed";
+    case BoundaryType::Smooth: return boundary.is_active ? "SolidStiched": "Solid";
+    }
+    LSTK_UNREACHABLE;
+}
+
+const char* patch_type_name(PatchType type)
+{
+    switch (type)
+    {
+    case PatchType::Distillation: return "DistillationQubit";
+    case PatchType::PreparedState:return "DistillationQubit";
+    case PatchType::Qubit: return "Qubit";
+    case PatchType::Routing: return "Ancilla";
+    case PatchType::Dead: return "Ancilla";
+    }
+    LSTK_UNREACHABLE;
+}
+
+// nullptr for activities that are shown as null
+const char* activity_type_name(PatchActivity activity)
+{
+    switch (activity)
+    {
+    case PatchActivity::None: return nullptr;
+    case PatchActivity::Measurement: return "Measurement";
+    case PatchActivity::Unitary: return "Unitary";
+    case PatchActivity::Distillation: return nullptr;
+    case PatchActivity::Dead: return nullptr;
+    }
+    LSTK_UNREACHABLE;
+}
+
+// Text of a patch without an id
+const char* unbound_patch_text(PatchType type, PatchActivity activity)
+{
+    if ((type==PatchType::Distillation && activity == PatchActivity::None) ||  type ==PatchType::Qubit)
+        return "Not bound";
+    return "";
+}
+
+const char* const time_to_next_magic_state_text = "Time to next magic state:";
+
+
+std::vector<uint32_t> distillation_timer_cells(const Layout& layout)
+{
+    const size_t width = static_cast<size_t>(layout.furthest_cell().col+1);
+    std::vector<uint32_t> timer_cells;
+    for(const MultipleCellsOccupiedByPatch& distillation_region: layout.distillation_regions())
+    {
+        const Cell& cell = distillation_region.sub_cells.front().cell;
+        timer_cells.push_back(static_cast<uint32_t>(static_cast<size_t>(cell.row)*width + static_cast<size_t>(cell.col)));
+    }
+    return timer_cells;
+}
+
+
+// Templates so that they also take a DenseSliceSnapshot, which only has the accessors these use
+template<class SliceType>
+json init_blank_json_slice(const SliceType& slice)
 {
     json out_rows = json::array();
     Cell furthest_cell = slice.get_layout().furthest_cell();
@@ -24,13 +91,14 @@ json init_blank_json_slice(const Slice& slice)
 }
 
 
-void annotate_time_to_next_distilled_state(json& json_slice, const Slice& slice)
+template<class SliceType>
+void annotate_time_to_next_distilled_state(json& json_slice, const SliceType& slice)
 {
     size_t distillation_region_counter = 0;
     for(const MultipleCellsOccupiedByPatch& distillation_region: slice.get_layout().distillation_regions())
     {
         const auto distillation_cell = distillation_region.sub_cells.front().cell;
-        json_slice[distillation_cell.row][distillation_cell.col]["text"] = std::string{"Time to next magic state:"} + std::to_string(
+        json_slice[distillation_cell.row][distillation_cell.col]["text"] = std::string{time_to_next_magic_state_text} + std::to_string(
                 slice.time_to_next_magic_state(distillation_region_counter++));
     }
 }
@@ -38,22 +106,11 @@ void annotate_time_to_next_distilled_state(json& json_slice, const Slice& slice)
 
 json boundaries_to_array_edges_json(const CellBoundaries& cell_boundaries)
 {
-    auto orientation_to_json = [](Boundary boundary){
-        switch (boundary.boundary_type)
-        {
-        case BoundaryType::None:return "None";
-        case BoundaryType::Connected: return boundary.is_active ? "AncillaJoin": "None";
-        case BoundaryType::Rough:return boundary.is_active ? "DashedStiched": "Dashed";
-        case BoundaryType::Smooth: return boundary.is_active ? "SolidStiched": "Solid";
-        }
-        LSTK_UNREACHABLE;
-    };
-
     return json{{"edges", {
-        {"Top", orientation_to_json(cell_boundaries.top)},
-        {"Bottom", orientation_to_json(cell_boundaries.bottom)},
-        {"Left", orientation_to_json(cell_boundaries.left)},
-        {"Right", orientation_to_json(cell_boundaries.right)}
+        {"Top", boundary_name(cell_boundaries.top)},
+        {"Bottom", boundary_name(cell_boundaries.bottom)},
+        {"Left", boundary_name(cell_boundaries.left)},
+        {"Right", boundary_name(cell_boundaries.right)}
     }}};
 }
 
@@ -61,46 +118,21 @@ json boundaries_to_array_edges_json(const CellBoundaries& cell_boundaries)
 json dense_patch_to_json(const DensePatch& p)
 {
     json visual_array_cell = boundaries_to_array_edges_json(p.boundaries);
-    visual_array_cell["patch_type"] = [&](){
-        switch (p.type)
-        {
-        case PatchType::Distillation: return "DistillationQubit";
-        case PatchType::PreparedState:return "DistillationQubit";
-        case PatchType::Qubit: return "Qubit";
-        case PatchType::Routing: return "Ancilla";
-        case PatchType::Dead: return "Ancilla";
-        }
-        LSTK_UNREACHABLE;
-    }();
+    visual_array_cell["patch_type"] = patch_type_name(p.type);
 
-    visual_array_cell["activity"] = {
-            {
-                    "activity_type",
-                    [&](){
-                        switch (p.activity)
-                        {
-                        case PatchActivity::None: return json();
-                        case PatchActivity::Measurement: return json("Measurement");
-                        case PatchActivity::Unitary: return json("Unitary");
-                        case PatchActivity::Distillation: return json();
-                        case PatchActivity::Dead: return json();
-                        }
-                        LSTK_UNREACHABLE;
-                    }()
-            }
-    };
+    const char* activity_type = activity_type_name(p.activity);
+    visual_array_cell["activity"] = {{"activity_type", activity_type ? json(activity_type) : json()}};
 
     if(p.id)
         visual_array_cell["text"] = std::string{"Id: "} + std::to_string(*p.id);
-    else if ((p.type==PatchType::Distillation && p.activity == PatchActivity::None) ||  p.type ==PatchType::Qubit)
-        visual_array_cell["text"] = "Not bound";
     else
-        visual_array_cell["text"] = "";
+        visual_array_cell["text"] = unbound_patch_text(p.type, p.activity);
     return visual_array_cell;
 }
 
 
-json slice_to_json(const DenseSlice& slice)
+template<class DenseSliceType>
+json dense_slice_to_json(const DenseSliceType& slice)
 {
     json out_slice = init_blank_json_slice(slice);
     slice.traverse_cells([&](const Cell& c, const std::optional<DensePatch>& p) {
@@ -113,6 +145,18 @@ json slice_to_json(const DenseSlice& slice)
 }
 
 
+json slice_to_json(const DenseSlice& slice)
+{
+    return dense_slice_to_json(slice);
+}
+
+
+json slice_to_json(const DenseSliceSnapshot& slice)
+{
+    return dense_slice_to_json(slice);
+}
+
+
 json slice_to_json(const SparseSlice& slice)
 {
     json out_slice = init_blank_json_slice(slice);
@@ -162,4 +206,200 @@ json slice_to_json(const SparseSlice& slice)
 
 
 
-}
\ No newline at end of file
+
+namespace {
+
+// Whitespace and punctuation of nlohmann::json::dump, for the indented and compact styles
+class JsonText
+{
+public:
+    JsonText(std::string& out, JsonStyle style) : out_(out), indented_(style == JsonStyle::Indented) {}
+
+    void line(size_t level)
+    {
+        if(!indented_) return;
+        out_ += '\n';
+        out_.append(level*indent_width, ' ');
+    }
+
+    void key(const char* key, size_t level)
+    {
+        line(level);
+        out_ += '"';
+        out_ += key;
+        out_ += indented_ ? "\": " : "\":";
+    }
+
+    // Our strings have nothing to escape
+    void string(const char* value)
+    {
+        out_ += '"';
+        out_ += value;
+        out_ += '"';
+    }
+
+    std::string& out() {return out_;}
+
+private:
+    static constexpr size_t indent_width = 3;
+
+    std::string& out_;
+    bool indented_;
+};
+
+// Nesting of cells in a slice: the slice array, then row arrays
+constexpr size_t cell_level = 2;
+
+}
+
+
+void SliceJsonFormatter::append(std::string& out, const DenseSlice& slice)
+{
+    update_timer_cells(slice.get_layout(), slice.packed_cells().size());
+    append_slice(out, static_cast<size_t>(slice.get_layout().furthest_cell().col+1), slice.packed_cells(), slice.patch_ids(),
+                 slice.time_to_next_magic_state_by_distillation_region);
+}
+
+void SliceJsonFormatter::append(std::string& out, const DenseSliceSnapshot& slice)
+{
+    update_timer_cells(slice.get_layout(), slice.cells.size());
+    append_slice(out, slice.width, slice.cells, slice.ids, slice.time_to_next_magic_state_by_distillation_region);
+}
+
+void SliceJsonFormatter::append(
+        std::string& out,
+        size_t width,
+        const std::vector<uint32_t>& timer_cells,
+        const std::vector<PackedCell>& cells,
+        const std::vector<PatchId>& ids,
+        const DistillationTimeMap& time_to_next_magic_state_by_distillation_region)
+{
+    timer_cells_layout_ = nullptr;
+    set_timer_cells(timer_cells, cells.size());
+    append_slice(out, width, cells, ids, time_to_next_magic_state_by_distillation_region);
+}
+
+void SliceJsonFormatter::append_slice(
+        std::string& out,
+        size_t width,
+        const std::vector<PackedCell>& cells,
+        const std::vector<PatchId>& ids,
+        const DistillationTimeMap& time_to_next_magic_state_by_distillation_region)
+{
+    JsonText text{out, style_};
+    out += '[';
+    for(size_t i = 0; i < cells.size(); i++)
+    {
+        if(i % width == 0)
+        {
+            if(i != 0)
+            {
+                text.line(cell_level-1);
+                out += "],";
+            }
+            text.line(cell_level-1);
+            out += '[';
+        }
+        else
+            out += ',';
+        text.line(cell_level);
+
+        const PackedCell& cell = cells[i];
+        const bool has_timer = timer_cells_[i] != no_timer;
+        if(!cell.is_occupied() && !has_timer)
+        {
+            out += "null";
+            continue;
+        }
+
+        if(cell.is_occupied())
+            out += cell_prefix(cell);
+        else
+        {
+            out += '{';
+            text.key("text", cell_level+1);
+        }
+
+        out += '"';
+        if(has_timer)
+        {
+            out += time_to_next_magic_state_text;
+            out += std::to_string(time_to_next_magic_state_by_distillation_region[timer_cells_[i]]);
+        }
+        else if(ids[i] != DenseSlice::no_patch_id)
+        {
+            out += "Id: ";
+            out += std::to_string(ids[i]);
+        }
+        else
+            out += unbound_patch_text(cell.type(), cell.activity());
+        out += '"';
+
+        text.line(cell_level);
+        out += '}';
+    }
+    text.line(cell_level-1);
+    out += ']';
+    text.line(0);
+    out += ']';
+}
+
+const std::string& SliceJsonFormatter::cell_prefix(const PackedCell& cell)
+{
+    auto [it, inserted] = cell_prefixes_.try_emplace(cell.bits());
+    if(!inserted) return it->second;
+
+    // Keys in the sorted order of nlohmann::json objects, up to the value of "text"
+    JsonText text{it->second, style_};
+    text.out() += '{';
+    text.key("activity", cell_level+1);
+    text.out() += '{';
+    text.key("activity_type", cell_level+2);
+    if(const char* activity_type = activity_type_name(cell.activity()))
+        text.string(activity_type);
+    else
+        text.out() += "null";
+    text.line(cell_level+1);
+    text.out() += "},";
+
+    text.key("edges", cell_level+1);
+    text.out() += '{';
+    const std::pair<const char*, CellSide> edges[] = {
+            {"Bottom", CellSide::Bottom}, {"Left", CellSide::Left}, {"Right", CellSide::Right}, {"Top", CellSide::Top}};
+    for(const auto& [name, side]: edges)
+    {
+        if(side != CellSide::Bottom) text.out() += ',';
+        text.key(name, cell_level+2);
+        text.string(boundary_name(cell.boundary(side)));
+    }
+    text.line(cell_level+1);
+    text.out() += "},";
+
+    text.key("patch_type", cell_level+1);
+    text.string(patch_type_name(cell.type()));
+    text.out() += ',';
+    text.key("text", cell_level+1);
+    return it->second;
+}
+
+void SliceJsonFormatter::update_timer_cells(const Layout& layout, size_t num_cells)
+{
+    if(timer_cells_layout_ == &layout && timer_cells_.size() == num_cells) return;
+
+    timer_cells_layout_ = &layout;
+    set_timer_cells(distillation_timer_cells(layout), num_cells);
+}
+
+void SliceJsonFormatter::set_timer_cells(const std::vector<uint32_t>& timer_cells, size_t num_cells)
+{
+    timer_cells_.assign(num_cells, no_timer);
+    // Like annotate_time_to_next_distilled_state, a later region's timer wins
+    for(uint32_t region = 0; region < timer_cells.size(); region++)
+    {
+        if(timer_cells[region] >= num_cells)
+            throw std::out_of_range(lstk::cat("Timer cell ", timer_cells[region], " is outside the slice"));
+        timer_cells_[timer_cells[region]] = region;
+    }
+}
+
+}
@@ -7,11 +7,14 @@
 #include <lsqecc/ls_instructions/boundary_rotation_injection_stream.hpp>
 #include <lsqecc/ls_instructions/teleported_s_gate_injection_stream.hpp>
 #include <lsqecc/ls_instructions/catalytic_s_gate_injection_stream.hpp>
+#include <lsqecc/ls_instructions/threaded_ls_instruction_stream.hpp>
 #include <lsqecc/layout/ascii_layout_spec.hpp>
 #include <lsqecc/layout/router.hpp>
 #include <lsqecc/layout/dynamic_layouts/compact_layout.hpp>
 #include <lsqecc/layout/dynamic_layouts/edpc_layout.hpp>
 #include <lsqecc/patches/slices_to_json.hpp>
+#include <lsqecc/patches/slice_json_writer.hpp>
+#include <lsqecc/patches/slice_binary.hpp>
 #include <lsqecc/patches/slice.hpp>
 #include <lsqecc/patches/slice_stats.hpp>
 #include <lsqecc/patches/dense_patch_computation.hpp>
@@ -22,6 +25,7 @@
 #include <argparse/argparse.h>
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <string_view>
 #include <sstream>
@@ -74,6 +78,11 @@ namespace lsqecc
         Local, Nonlocal
     };
 
+    enum class SliceFormat
+    {
+        Json, Binary, BinaryDelta
+    };
+
     DistillationOptions make_distillation_options(argparse::ArgumentParser& parser)
     {
         DistillationOptions distillation_options;
@@ -125,9 +134,21 @@ namespace lsqecc
                 .names({"-P", "--pipeline"})
                 .description("pipeline mode: stream (default), dag")
                 .required(false);
+        parser.add_argument()
+                .names({"--dag-window"})
+                .description("Requires -P dag. Keep at most this many instructions in the dag, reading more as they are applied (default: the whole circuit)")
+                .required(false);
+        parser.add_argument()
+                .names({"--scheduler"})
+                .description("Requires -P dag. Order in which ready instructions are tried: label_order (default, circuit order), critical_path (longest chains of dependants first)")
+                .required(false);
+        parser.add_argument()
+                .names({"--threads"})
+                .description("Number of threads (default 1). With 2 or more, reading and generating instructions runs on a thread of its own and slices are formatted as JSON on the other threads (at least one), while slicing stays on one thread")
+                .required(false);
         parser.add_argument()
                 .names({"-g", "--graph-search"})
-                .description("Set a graph search provider: djikstra (default), astar, boost (not always available)")
+                .description("Set a graph search provider: djikstra (default), astar, bucket (A* with integer costs), bitboard (BFS on bitboards), landmarks (A* with precomputed layout distances), boost and boost_incremental (not always available)")
                 .required(false);
         parser.add_argument()
                 .names({"--graceful"})
@@ -145,6 +166,18 @@ namespace lsqecc
                 .names({"--noslices"})
                 .description("Do the slicing but don't write the slices out")
                 .required(false);
+        parser.add_argument()
+                .names({"--compact-json"})
+                .description("Write the JSON of each slice on a single line, without indentation")
+                .required(false);
+        parser.add_argument()
+                .names({"--slice-format"})
+                .description("Format of the slices: json (default), binary, binary_delta (binary with the changes from the previous slice). Convert binary to json with lsqecc_slices_to_json")
+                .required(false);
+        parser.add_argument()
+                .names({"--keyframe-interval"})
+                .description("Requires a binary --slice-format. Make every this many slices a keyframe, where reading can start (default 128, 0 for only the first)")
+                .required(false);
         parser.add_argument()
                 .names({"--cnotcorrections"})
                 .description("Add Xs and Zs to correct the the negative outcomes: never (default), always") // TODO add random
@@ -192,11 +225,47 @@ namespace lsqecc
             return 0;
         }
 
+        SliceFormat slice_format = SliceFormat::Json;
+        if(parser.exists("slice-format"))
+        {
+            auto format_arg = parser.get<std::string>("slice-format");
+            if (format_arg=="json")
+                slice_format = SliceFormat::Json;
+            else if (format_arg=="binary")
+                slice_format = SliceFormat::Binary;
+            else if (format_arg=="binary_delta")
+                slice_format = SliceFormat::BinaryDelta;
+            else
+            {
+                err_stream << "Unknown slice format " << format_arg << std::endl;
+                return -1;
+            }
+
+            if(slice_format != SliceFormat::Json && parser.exists("compact-json"))
+            {
+                err_stream << "--compact-json requires --slice-format json" << std::endl;
+                return -1;
+            }
+        }
+
+        size_t keyframe_interval = SliceBinaryWriter::default_keyframe_interval;
+        if(parser.exists("keyframe-interval"))
+        {
+            if(slice_format == SliceFormat::Json)
+            {
+                err_stream << "--keyframe-interval requires a binary --slice-format" << std::endl;
+                return -1;
+            }
+            keyframe_interval = parser.get<size_t>("keyframe-interval");
+        }
+
         std::reference_wrapper<std::ostream> bulk_output_stream = std::ref(out_stream);
         std::unique_ptr<std::ostream> _ofstream_store;
         if(parser.exists("o"))
         {
-            _ofstream_store = std::make_unique<std::ofstream>(parser.get<std::string>("o"));
+            _ofstream_store = std::make_unique<std::ofstream>(
+                    parser.get<std::string>("o"),
+                    slice_format == SliceFormat::Json ? std::ios::out : std::ios::out | std::ios::binary);
             bulk_output_stream = std::ref(*_ofstream_store);
         }
 
@@ -256,6 +325,51 @@ namespace lsqecc
             }
         }
 
+        DagPipelineOptions dag_options;
+        if (parser.exists("dag-window"))
+        {
+            if (pipeline_mode != PipelineMode::Dag)
+            {
+                err_stream << "--dag-window requires -P dag" << std::endl;
+                return -1;
+            }
+            dag_options.window = parser.get<size_t>("dag-window");
+            if (*dag_options.window == 0)
+            {
+                err_stream << "--dag-window must be at least 1" << std::endl;
+                return -1;
+            }
+        }
+        if (parser.exists("scheduler"))
+        {
+            if (pipeline_mode != PipelineMode::Dag)
+            {
+                err_stream << "--scheduler requires -P dag" << std::endl;
+                return -1;
+            }
+            auto mode_arg = parser.get<std::string>("scheduler");
+            if (mode_arg == "label_order")
+                dag_options.scheduler = DagScheduler::LabelOrder;
+            else if (mode_arg == "critical_path")
+                dag_options.scheduler = DagScheduler::CriticalPath;
+            else
+            {
+                err_stream << "Unknown scheduler " << mode_arg << std::endl;
+                return -1;
+            }
+        }
+
+        size_t num_threads = 1;
+        if (parser.exists("threads"))
+        {
+            num_threads = parser.get<size_t>("threads");
+            if (num_threads == 0)
+            {
+                err_stream << "--threads must be at least 1" << std::endl;
+                return -1;
+            }
+        }
+
 
         std::reference_wrapper<std::istream> input_file_stream = std::ref(in_stream);
         std::unique_ptr<std::ifstream> _file_to_read_store;
@@ -280,8 +394,10 @@ namespace lsqecc
         if(!parser.exists("q"))
         {
             instruction_stream = std::make_unique<LSInstructionStreamFromFile>(input_file_stream.get());
-            id_generator.set_start(*std::max(instruction_stream->core_qubits().begin(),
-                                             instruction_stream->core_qubits().end()));
+            // New ids start after the largest core qubit, like they start after the qreg for QASM input
+            const auto& core_qubits = instruction_stream->core_qubits();
+            if(!core_qubits.empty())
+                id_generator.set_start(*std::max_element(core_qubits.begin(), core_qubits.end()) + 1);
             if( print_dag_mode == PrintDagMode::Input )
             {
                 auto dag = dag::full_dependency_dag_from_instruction_stream(*instruction_stream);
@@ -391,14 +507,14 @@ namespace lsqecc
                                           : std::nullopt;
 
 
-        std::unique_ptr<Router> router = std::make_unique<CustomDPRouter>();
+        bool cached_router = false;
         if(parser.exists("r"))
         {
             auto router_name = parser.get<std::string>("r");
             if(router_name =="graph_search") //TODO change to djikstra
                 LSTK_NOOP;// Already set
             else if(router_name=="graph_search_cached")
-                router = std::make_unique<CachedRouter>();
+                cached_router = true;
             else
             {
                 err_stream <<"Unknown router: "<< router_name << std::endl;
@@ -406,16 +522,24 @@ namespace lsqecc
             }
         }
 
-        router->set_graph_search_provider(GraphSearchProvider::Djikstra);
+        GraphSearchProvider graph_search_provider = GraphSearchProvider::Djikstra;
         if(parser.exists("g"))
         {
             auto router_name = parser.get<std::string>("g");
             if(router_name =="astar")
-                router->set_graph_search_provider(GraphSearchProvider::AStar);
+                graph_search_provider = GraphSearchProvider::AStar;
             else if (router_name=="djikstra")
-                router->set_graph_search_provider(GraphSearchProvider::Djikstra);
+                graph_search_provider = GraphSearchProvider::Djikstra;
+            else if (router_name=="bucket")
+                graph_search_provider = GraphSearchProvider::BucketAStar;
+            else if (router_name=="bitboard")
+                graph_search_provider = GraphSearchProvider::Bitboard;
+            else if (router_name=="landmarks")
+                graph_search_provider = GraphSearchProvider::LandmarkAStar;
             else if(router_name=="boost")
-                router->set_graph_search_provider(GraphSearchProvider::Boost);
+                graph_search_provider = GraphSearchProvider::Boost;
+            else if(router_name=="boost_incremental")
+                graph_search_provider = GraphSearchProvider::BoostIncremental;
             else
             {
                 err_stream<<"Unknown router: "<< router_name <<std::endl;
@@ -423,20 +547,38 @@ namespace lsqecc
             }
         }
 
+        auto make_router = [&]() -> std::unique_ptr<Router>
+        {
+            std::unique_ptr<Router> router = cached_router ? std::unique_ptr<Router>{std::make_unique<CachedRouter>()}
+                                                           : std::make_unique<CustomDPRouter>();
+            router->set_graph_search_provider(graph_search_provider);
+            return router;
+        };
+        std::unique_ptr<Router> router = make_router();
+
 
         bool print_slices = !parser.exists("noslices") && lli_print_mode == LLIPrintMode::None;
         DenseSliceVisitor slice_visitor = [](const DenseSlice& s) -> void {LSTK_UNUSED(s);};
-        bool is_first_slice = true;
-        if(print_slices)
+        std::optional<SliceJsonWriter> slice_writer;
+        std::optional<SliceBinaryWriter> binary_slice_writer;
+        if(print_slices && slice_format != SliceFormat::Json)
         {
-            slice_visitor = [&bulk_output_stream, &is_first_slice](const DenseSlice & s){
-                if(is_first_slice)
-                {
-                    bulk_output_stream.get() << "[\n" << slice_to_json(s).dump(3);
-                    is_first_slice = false;
-                }
-                else
-                    bulk_output_stream.get() << ",\n" << slice_to_json(s).dump(3);
+            // Cheap enough to write inline
+            binary_slice_writer.emplace(
+                    bulk_output_stream.get(), *layout, slice_format == SliceFormat::BinaryDelta, keyframe_interval);
+            slice_visitor = [&binary_slice_writer](const DenseSlice & s){
+                binary_slice_writer->write(s);
+            };
+        }
+        else if(print_slices)
+        {
+            // Slicing and reading instructions take a thread each, the rest format slices
+            slice_writer.emplace(
+                    bulk_output_stream.get(),
+                    num_threads > 1 ? std::max<size_t>(num_threads, 3) - 2 : 0,
+                    parser.exists("compact-json") ? JsonStyle::Compact : JsonStyle::Indented);
+            slice_visitor = [&slice_writer](const DenseSlice & s){
+                slice_writer->write(s);
             };
         }
 
@@ -484,12 +626,54 @@ namespace lsqecc
         }
 
 
+        // For the stats, the slice count of the dag pipeline with label order to compare the scheduler against. This
+        // slices the instructions twice, so they are all read up front
+        std::optional<size_t> label_order_slice_count;
+        if (output_format_mode == OutputFormatMode::Stats && pipeline_mode == PipelineMode::Dag
+            && dag_options.scheduler != DagScheduler::LabelOrder)
+        {
+            std::vector<LSInstruction> instructions;
+            while (instruction_stream->has_next_instruction())
+                instructions.push_back(instruction_stream->get_next_instruction());
+            const tsl::ordered_set<PatchId> core_qubits = instruction_stream->core_qubits();
+
+            DagPipelineOptions label_order_options = dag_options;
+            label_order_options.scheduler = DagScheduler::LabelOrder;
+            auto label_order_router = make_router();
+            try
+            {
+                label_order_slice_count = run_through_dense_slices(
+                        LSInstructionStreamFromVector{instructions, core_qubits},
+                        true,
+                        label_order_options,
+                        compile_mode == CompilationMode::Local,
+                        *layout,
+                        *label_order_router,
+                        std::nullopt,
+                        [](const DenseSlice&){},
+                        [](const LSInstruction&){},
+                        false).slice_count();
+            }
+            catch (const std::exception& e)
+            {
+                err_stream << "Could not slice with label_order to compare: " << e.what() << std::endl;
+            }
+
+            instruction_stream = std::make_unique<LSInstructionStreamFromVector>(std::move(instructions), core_qubits);
+        }
+
+        // Declared after the layout, which the injection streams read, so that the producer thread stops before the
+        // layout goes away
+        std::unique_ptr<LSInstructionStream> sliced_instruction_stream = std::move(instruction_stream);
+        if(num_threads > 1)
+            sliced_instruction_stream = std::make_unique<ThreadedLSInstructionStream>(std::move(sliced_instruction_stream));
+
         auto start = lstk::now();
 
-        std::unique_ptr<PatchComputationResult> computation_result = 
-            std::make_unique<DensePatchComputationResult>(run_through_dense_slices(
-                    std::move(*instruction_stream),
+        auto dense_result = std::make_unique<DensePatchComputationResult>(run_through_dense_slices(
+                    std::move(*sliced_instruction_stream),
                     pipeline_mode == PipelineMode::Dag,
+                    dag_options,
                     compile_mode == CompilationMode::Local,
                     *layout,
                     *router,
@@ -498,6 +682,12 @@ namespace lsqecc
                     instruction_visitor,
                     parser.exists("graceful")
         ));
+        dense_result->label_order_slice_count_ = label_order_slice_count;
+        std::unique_ptr<PatchComputationResult> computation_result = std::move(dense_result);
+        if(slice_writer)
+            slice_writer->finish();
+        if(binary_slice_writer)
+            binary_slice_writer->finish();
 
         if(parser.exists("o") || parser.exists("noslices"))
         {
@@ -514,12 +704,14 @@ namespace lsqecc
             }
             
             if ( output_format_mode == OutputFormatMode::Stats)
-                out_stream << slice_stats << std::endl; 
+            {
+                out_stream << slice_stats << std::endl;
+                computation_result->print_stats(out_stream);
+                router->print_stats(out_stream);
+            }
                 
         }
         
-        if(print_slices)
-            bulk_output_stream.get() << "]" <<std::endl;
         if (lli_print_mode == LLIPrintMode::Sliced)
             bulk_output_stream.get() << std::endl;
 
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <lsqecc/dag/dense_directed_graph.hpp>
+
+using namespace lsqecc::dag;
+
+
+TEST(dense_directed_graph, heads_and_tails_after_update)
+{
+    DenseDirectedGraph g;
+    g.add_edge(0, 2);
+    g.add_edge(1, 2);
+    g.add_edge(2, 3);
+    g.add_edge(2, 4);
+    g.add_edge(100, 0);
+    g.remove_node(3);
+    /* Graph after update (all edges pointing downwards):
+    100
+    |
+    0   1
+     \ /
+      2
+       \
+        4
+    */
+
+    ASSERT_EQ((std::vector<label_t>{1, 100}), g.heads());
+    ASSERT_EQ((std::vector<label_t>{4}), g.tails());
+    ASSERT_EQ(2, g.in_degree(2));
+    ASSERT_FALSE(g.contains(3));
+    ASSERT_EQ(5, g.size());
+}
+
+
+TEST(dense_directed_graph, expand)
+{
+    DenseDirectedGraph g;
+    g.add_edge(0, 2);
+    g.add_edge(1, 2);
+    g.add_edge(2, 3);
+    g.add_edge(2, 4);
+
+    g.expand(2, {100, 101, 102});
+
+    ASSERT_EQ(7, g.size());
+    ASSERT_EQ((std::vector<label_t>{100}), g.successors(0));
+    ASSERT_EQ((std::vector<label_t>{100}), g.successors(1));
+    ASSERT_EQ((std::vector<label_t>{101}), g.successors(100));
+    ASSERT_EQ((std::vector<label_t>{102}), g.successors(101));
+    ASSERT_EQ((std::vector<label_t>{3, 4}), g.successors(102));
+    ASSERT_EQ((std::vector<label_t>{0, 1}), g.predecessors(100));
+    ASSERT_EQ((std::vector<label_t>{102}), g.predecessors(3));
+    ASSERT_EQ((std::vector<label_t>{102}), g.predecessors(4));
+    ASSERT_THROW(g.successors(2), std::runtime_error);
+}
+
+
+TEST(dense_directed_graph, same_order_as_directed_graph)
+{
+    DirectedGraph sparse;
+    DenseDirectedGraph dense;
+    for(label_t label = 0; label < 12; label++)
+    {
+        sparse.add_node(label);
+        dense.add_node(label);
+    }
+    for(auto [from, to] : std::vector<std::pair<label_t, label_t>>{
+            {0, 2}, {1, 2}, {2, 3}, {2, 4}, {3, 5}, {4, 5}, {5, 9}, {6, 7}, {7, 4}, {7, 8}, {8, 9}, {10, 11}})
+    {
+        sparse.add_edge(from, to);
+        dense.add_edge(from, to);
+    }
+
+    ASSERT_EQ(sparse.topological_order_tails_first(), dense.topological_order_tails_first());
+
+    Map<label_t, std::string> contents{{2, "two"}};
+    std::stringstream sparse_graphviz, dense_graphviz;
+    sparse.to_graphviz(sparse_graphviz, contents);
+    dense.to_graphviz(dense_graphviz, contents);
+    ASSERT_EQ(sparse_graphviz.str(), dense_graphviz.str());
+}
+
+
+TEST(dense_directed_graph, removed_nodes_leave_no_trace)
+{
+    DenseDirectedGraph g;
+    const label_t n = 200;
+    for(label_t label = 1; label < n; label++)
+    {
+        g.add_edge(0, label); // Spills 0's successors to the heap
+        g.add_edge(label-1, label);
+    }
+    g.add_edge(0, 5);
+    ASSERT_EQ(n-1, g.successors(0).size());
+    ASSERT_EQ(2, g.in_degree(5));
+
+    g.remove_node(0);
+    ASSERT_EQ(1, g.in_degree(5));
+    ASSERT_EQ((std::vector<label_t>{1}), g.heads());
+
+    for(label_t label = 1; label < n; label++)
+    {
+        ASSERT_EQ((std::vector<label_t>{label}), g.heads());
+        g.remove_node(label);
+    }
+    ASSERT_TRUE(g.empty());
+    ASSERT_FALSE(g.contains(0));
+
+    // Labels can keep growing after the front was trimmed
+    g.add_edge(n, n+1);
+    ASSERT_EQ((std::vector<label_t>{n}), g.heads());
+}
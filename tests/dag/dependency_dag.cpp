@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <lsqecc/dag/critical_path.hpp>
 #include <lsqecc/dag/dependency_dag.hpp>
 
 
@@ -167,4 +168,85 @@ TEST(dependency_dag, simulate_head_expansion_after_retry)
     ss << "}" << std::endl;
 
     ASSERT_EQ(ss.str(), to_graphviz(dag));
-}
\ No newline at end of file
+}
+
+TEST(dependency_dag, ready_instructions_follow_heads)
+{
+    DependencyDag<TestInstruction> dag;
+    auto check = [&](){
+        const auto heads = get_graph_for_testing(dag).heads();
+        ASSERT_EQ((std::set<label_t>{heads.begin(), heads.end()}), dag.ready_instructions());
+    };
+
+    dag.push_instruction_based_on_commutation({"A", 0});
+    dag.push_instruction_based_on_commutation({"B", 1});
+    dag.push_instruction_based_on_commutation({"C", 0});
+    dag.push_instruction_based_on_commutation({"D", 1});
+    dag.push_instruction_based_on_commutation({"E", 0});
+    check();
+    ASSERT_EQ((std::vector<label_t>{0, 1}), dag.applicable_instructions());
+
+    dag.expand(0, {{"F", 0}, {"G", 0}}, true);
+    check();
+    dag.pop_head(5);
+    check();
+    dag.pop_head(6);
+    check();
+    ASSERT_EQ((std::vector<label_t>{1, 2}), dag.applicable_instructions());
+
+    dag.pop_head(1);
+    dag.pop_head(2);
+    check();
+    ASSERT_EQ((std::vector<label_t>{3, 4}), dag.applicable_instructions());
+}
+
+TEST(dependency_dag, critical_path_priorities)
+{
+    DependencyDag<TestInstruction> dag;
+    dag.push_instruction_based_on_commutation({"A", 0});
+    dag.push_instruction_based_on_commutation({"B", 1});
+    dag.push_instruction_based_on_commutation({"C", 0});
+    dag.push_instruction_based_on_commutation({"D", 2});
+    dag.push_instruction_based_on_commutation({"E", 0});
+
+    CriticalPathPriorities priorities;
+    priorities.instructions_added(dag, dag.size());
+    ASSERT_EQ(3, priorities.of(0));
+    ASSERT_EQ(1, priorities.of(1));
+    ASSERT_EQ(1, priorities.of(3));
+    ASSERT_EQ(2, priorities.of(2));
+
+    std::vector<label_t> ready{1, 3, 0};
+    priorities.sort(ready);
+    ASSERT_EQ((std::vector<label_t>{0, 1, 3}), ready);
+
+    // Too few new instructions to recompute, the new one gets the lowest priority
+    dag.pop_head(0);
+    label_t f = dag.push_instruction_based_on_commutation({"F", 3});
+    priorities.instructions_added(dag, 1);
+    ASSERT_EQ(0, priorities.of(f));
+    ASSERT_EQ(2, priorities.of(2));
+}
+
+TEST(dependency_dag, expand_moves_proximate_dependencies_to_the_ends)
+{
+    DependencyDag<TestInstruction> dag;
+    dag.push_instruction_based_on_commutation({"A", 0});
+
+    dag.expand(0, {{"B", 0}, {"C", 0}, {"D", 0}}, true); // 1 -> 2 -> 3
+    dag.expand(2, {{"E", 0}, {"F", 0}}, true); // 1 -> 4 -> 5 -> 3
+    dag.expand(5, {{"G", 0}}, true); // 1 -> 4 -> 6 -> 3
+
+    std::stringstream ss;
+    dag.to_graphviz(ss);
+    ASSERT_NE(std::string::npos, ss.str().find("  1 -> 4 [penwidth=5];\n  4 -> 6 [penwidth=5];\n  6 -> 3 [penwidth=5];\n"));
+    ASSERT_EQ(std::string::npos, ss.str().find("2 ["));
+    ASSERT_EQ(std::string::npos, ss.str().find("5 ["));
+
+    // Popping the middle of the chain makes its proximate predecessor a proximate head and drops its dependencies
+    dag.pop_head(6);
+    ASSERT_EQ((std::vector<label_t>{4}), dag.proximate_instructions());
+    std::stringstream after_pop;
+    dag.to_graphviz(after_pop);
+    ASSERT_NE(std::string::npos, after_pop.str().find("  1 -> 4 [penwidth=5];\n}"));
+}
@@ -9,10 +9,109 @@ using namespace lsqecc;
 TEST(commutation_trait, can_commute)
 {
     ASSERT_TRUE(dag::CommutationTrait<gates::Gate>::can_commute(gates::X(0) COMMA gates::X(1)));
-    ASSERT_FALSE(dag::CommutationTrait<gates::Gate>::can_commute(gates::X(0) COMMA gates::X(0)));
+    ASSERT_TRUE(dag::CommutationTrait<gates::Gate>::can_commute(gates::X(0) COMMA gates::X(0)));
+    ASSERT_FALSE(dag::CommutationTrait<gates::Gate>::can_commute(gates::X(0) COMMA gates::Z(0)));
+    ASSERT_FALSE(dag::CommutationTrait<gates::Gate>::can_commute(gates::H(0) COMMA gates::H(0)));
+    ASSERT_TRUE(dag::CommutationTrait<gates::Gate>::can_commute(gates::T(0) COMMA gates::SDg(0))); // Both diagonal
+    ASSERT_TRUE(dag::CommutationTrait<gates::Gate>::can_commute(gates::T(0) COMMA gates::RZ{0 COMMA {1 COMMA 8}}));
 
     ASSERT_TRUE(dag::CommutationTrait<gates::Gate>::can_commute(gates::CNOT(0 COMMA 1) COMMA gates::CNOT(2 COMMA 3))); // All different
     ASSERT_TRUE(dag::CommutationTrait<gates::Gate>::can_commute(gates::CNOT(0 COMMA 2) COMMA gates::CNOT(1 COMMA 2))); // Same control
-    ASSERT_FALSE(dag::CommutationTrait<gates::Gate>::can_commute(gates::CNOT(0 COMMA 1) COMMA gates::CNOT(0 COMMA 2))); // Same target
-    ASSERT_FALSE(dag::CommutationTrait<gates::Gate>::can_commute(gates::CNOT(0 COMMA 1) COMMA gates::CNOT(0 COMMA 1))); // All the same
+    ASSERT_TRUE(dag::CommutationTrait<gates::Gate>::can_commute(gates::CNOT(0 COMMA 1) COMMA gates::CNOT(0 COMMA 2))); // Same target
+    ASSERT_TRUE(dag::CommutationTrait<gates::Gate>::can_commute(gates::CNOT(0 COMMA 1) COMMA gates::CNOT(0 COMMA 1))); // All the same
+    ASSERT_FALSE(dag::CommutationTrait<gates::Gate>::can_commute(gates::CNOT(0 COMMA 1) COMMA gates::CNOT(1 COMMA 0))); // Swapped
+    ASSERT_FALSE(dag::CommutationTrait<gates::Gate>::can_commute(gates::CNOT(0 COMMA 1) COMMA gates::CNOT(2 COMMA 0))); // Chained
+
+    ASSERT_TRUE(dag::CommutationTrait<gates::Gate>::can_commute(gates::CNOT(0 COMMA 1) COMMA gates::T(1))); // On the control
+    ASSERT_TRUE(dag::CommutationTrait<gates::Gate>::can_commute(gates::CNOT(0 COMMA 1) COMMA gates::X(0))); // On the target
+    ASSERT_FALSE(dag::CommutationTrait<gates::Gate>::can_commute(gates::CNOT(0 COMMA 1) COMMA gates::T(0)));
+    ASSERT_FALSE(dag::CommutationTrait<gates::Gate>::can_commute(gates::CNOT(0 COMMA 1) COMMA gates::H(1)));
+}
+
+
+TEST(commutation_trait, can_commute_ls_instructions)
+{
+    auto measure = [](tsl::ordered_map<PatchId, PauliOperator> observable){
+        return LSInstruction{MultiPatchMeasurement{std::move(observable), false}};
+    };
+    auto gate = [](PatchId target, SingleQubitOp::Operator op){
+        return LSInstruction{SingleQubitOp{target, op}};
+    };
+    using Trait = dag::CommutationTrait<LSInstruction>;
+    using Op = SingleQubitOp::Operator;
+
+    ASSERT_TRUE(Trait::can_commute(measure({{0, PauliOperator::Z}, {1, PauliOperator::Z}}),
+                                   measure({{0, PauliOperator::Z}, {2, PauliOperator::X}})));
+    ASSERT_FALSE(Trait::can_commute(measure({{0, PauliOperator::Z}, {1, PauliOperator::Z}}),
+                                    measure({{0, PauliOperator::X}, {2, PauliOperator::X}})));
+    // Anticommute on both patches
+    ASSERT_TRUE(Trait::can_commute(measure({{0, PauliOperator::Z}, {1, PauliOperator::Z}}),
+                                   measure({{0, PauliOperator::X}, {1, PauliOperator::X}})));
+
+    ASSERT_TRUE(Trait::can_commute(measure({{0, PauliOperator::Z}, {1, PauliOperator::Z}}), gate(0, Op::S)));
+    ASSERT_TRUE(Trait::can_commute(measure({{0, PauliOperator::X}, {1, PauliOperator::Z}}), gate(0, Op::X)));
+    ASSERT_FALSE(Trait::can_commute(measure({{0, PauliOperator::X}, {1, PauliOperator::Z}}), gate(0, Op::Z)));
+    ASSERT_FALSE(Trait::can_commute(gate(0, Op::H), gate(0, Op::H)));
+
+    // Single patch measurements consume their patch
+    ASSERT_FALSE(Trait::can_commute(LSInstruction{SinglePatchMeasurement{0, PauliOperator::Z, false}}, gate(0, Op::Z)));
+}
+
+
+TEST(dependency_dag, local_commutation_only_adds_frontier_edges)
+{
+    dag::DependencyDag<gates::Gate> dag;
+    dag.push_instruction_based_on_local_commutation(gates::H(0));
+    dag.push_instruction_based_on_local_commutation(gates::CNOT(1 COMMA 0));
+    dag.push_instruction_based_on_local_commutation(gates::CNOT(2 COMMA 0));
+    dag.push_instruction_based_on_local_commutation(gates::H(0));
+    dag.push_instruction_based_on_local_commutation(gates::Z(1));
+
+    const auto& edges = dag::get_edges_for_testing(dag::get_graph_for_testing(dag));
+    auto successors = [&](dag::label_t label){
+        return std::vector<dag::label_t>{edges.at(label).begin(), edges.at(label).end()};
+    };
+    ASSERT_EQ((std::vector<dag::label_t>{1, 2}), successors(0)); // Not 3, which comes after 0 through 1 and 2
+    ASSERT_EQ((std::vector<dag::label_t>{3, 4}), successors(1));
+    ASSERT_EQ((std::vector<dag::label_t>{3}), successors(2));
+    ASSERT_TRUE(successors(3).empty());
+}
+
+
+TEST(dependency_dag, local_commutation_keeps_all_orderings)
+{
+    std::vector<gates::Gate> circuit;
+    for(QubitNum i = 0; i < 60; i++)
+    {
+        const QubitNum a = (i*7)%5, b = (i*3+1)%5;
+        if(a == b) circuit.push_back(i%2 ? gates::Gate{gates::T(a)} : gates::Gate{gates::H(a)});
+        else circuit.push_back(gates::CNOT(b, a));
+    }
+
+    dag::DependencyDag<gates::Gate> full, local;
+    for(const auto& gate : circuit)
+    {
+        full.push_instruction_based_on_commutation(gates::Gate{gate});
+        local.push_instruction_based_on_local_commutation(gates::Gate{gate});
+    }
+
+    const auto& full_edges = dag::get_edges_for_testing(dag::get_graph_for_testing(full));
+    const auto& local_edges = dag::get_edges_for_testing(dag::get_graph_for_testing(local));
+
+    // Labels are in insertion order, so reachability can be computed in reverse label order
+    std::vector<std::vector<bool>> reachable(circuit.size(), std::vector<bool>(circuit.size(), false));
+    for(size_t from = circuit.size(); from-- > 0;)
+    {
+        for(dag::label_t to : local_edges.at(from))
+        {
+            ASSERT_TRUE(full_edges.at(from).contains(to));
+            reachable[from][to] = true;
+            for(size_t further = 0; further < circuit.size(); further++)
+                if(reachable[to][further]) reachable[from][further] = true;
+        }
+    }
+
+    for(size_t from = 0; from < circuit.size(); from++)
+        for(dag::label_t to : full_edges.at(from))
+            ASSERT_TRUE(reachable[from][to]) << from << " -> " << to;
 }
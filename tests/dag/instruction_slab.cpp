@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include <lsqecc/dag/instruction_slab.hpp>
+
+using namespace lsqecc::dag;
+
+
+TEST(instruction_slab, insert_at_erase)
+{
+    InstructionSlab<std::string> slab;
+    slab.insert(3, "three");
+    slab.insert(4, "four");
+    slab.insert(7, "seven");
+
+    ASSERT_EQ(3, slab.size());
+    ASSERT_EQ("four", slab.at(4));
+    ASSERT_FALSE(slab.contains(5));
+    ASSERT_THROW(slab.at(5), std::out_of_range);
+    ASSERT_THROW(slab.insert(4, "again"), std::logic_error);
+
+    slab.erase(4);
+    ASSERT_FALSE(slab.contains(4));
+    ASSERT_EQ(2, slab.size());
+
+    std::vector<std::pair<label_t, std::string>> contents;
+    slab.for_each([&](label_t label, const std::string& s){contents.emplace_back(label, s);});
+    ASSERT_EQ((std::vector<std::pair<label_t, std::string>>{{3, "three"}, {7, "seven"}}), contents);
+}
+
+
+TEST(instruction_slab, reuses_slots_and_keeps_references)
+{
+    InstructionSlab<std::string> slab;
+    const label_t live = 300;
+    for(label_t label = 0; label < live; label++)
+        slab.insert(label, std::to_string(label));
+    const std::string& first = slab.at(0);
+    const size_t capacity = slab.capacity();
+
+    // Drain and refill like the dag pipeline does, many times over what fits
+    for(label_t label = live; label < 100*live; label++)
+    {
+        slab.erase(label - live + 1);
+        slab.insert(label, std::to_string(label));
+    }
+
+    ASSERT_EQ(capacity, slab.capacity());
+    ASSERT_EQ(&first, &slab.at(0));
+    ASSERT_EQ("0", first);
+    ASSERT_EQ(std::to_string(100*live - 1), slab.at(100*live - 1));
+    ASSERT_EQ(live, slab.size());
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <lsqecc/layout/router.hpp>
+#include <lsqecc/patches/dense_slice.hpp>
+#include <lsqecc/layout/ascii_layout_spec.hpp>
+
+using namespace lsqecc;
+
+
+TEST(CachedRouter, revalidates_cached_routes)
+{
+    LayoutFromSpec layout{"QrrrQ\nrrrrr\nrrrrr\n", DistillationOptions{}};
+    DenseSlice slice{layout, {0, 1}};
+    CachedRouter router;
+
+    auto route = router.find_routing_ancilla(slice, 0, PauliOperator::Z, 1, PauliOperator::Z);
+    ASSERT_TRUE(route);
+    ASSERT_FALSE(route->cells.empty());
+    ASSERT_EQ(1, router.cache_stats().misses);
+
+    ASSERT_EQ(route->cells, router.find_routing_ancilla(slice, 0, PauliOperator::Z, 1, PauliOperator::Z)->cells);
+    ASSERT_EQ(1, router.cache_stats().hits);
+
+    // Block the cached route, the router should notice and route around it
+    const Cell blocked = route->cells[route->cells.size()/2].cell;
+    slice.place_sparse_patch(SparsePatch{{PatchType::Routing, PatchActivity::None},
+                                         LayoutHelpers::basic_square_patch(blocked).cells}, false);
+    auto rerouted = router.find_routing_ancilla(slice, 0, PauliOperator::Z, 1, PauliOperator::Z);
+    ASSERT_EQ(1, router.cache_stats().invalidations);
+    ASSERT_TRUE(rerouted);
+    for(const auto& occupied_cell : rerouted->cells)
+        ASSERT_NE(blocked, occupied_cell.cell);
+}
+
+TEST(CachedRouter, evicts_least_recently_used)
+{
+    LayoutFromSpec layout{"QrrrQ\nrrrrr\nrrrrr\n", DistillationOptions{}};
+    DenseSlice slice{layout, {0, 1}};
+    CachedRouter router{1};
+
+    router.find_routing_ancilla(slice, 0, PauliOperator::Z, 1, PauliOperator::Z);
+    router.find_routing_ancilla(slice, 1, PauliOperator::Z, 0, PauliOperator::Z);
+    ASSERT_EQ(1, router.cache_stats().evictions);
+    router.find_routing_ancilla(slice, 0, PauliOperator::Z, 1, PauliOperator::Z);
+    ASSERT_EQ(0, router.cache_stats().hits);
+    ASSERT_EQ(3, router.cache_stats().misses);
+}
+
+#ifdef ENABLE_BOOST_GRAPH_SEARCH
+TEST(BoostIncrementalGraph, follows_occupancy_changes)
+{
+    LayoutFromSpec layout{"QrrrQ\nrrrrr\nrrrrr\n", DistillationOptions{}};
+    DenseSlice slice{layout, {0, 1}};
+    boost_graph_search::IncrementalGraph graph;
+    custom_graph_search::SearchWorkspace workspace;
+
+    auto route_length = [&](){
+        auto route = boost_graph_search::graph_search_route_ancilla(
+                slice, 0, PauliOperator::Z, 1, PauliOperator::Z, graph);
+        auto expected = custom_graph_search::graph_search_route_ancilla(
+                slice, 0, PauliOperator::Z, 1, PauliOperator::Z, custom_graph_search::Heuristic::None, workspace);
+        EXPECT_EQ(expected.has_value(), route.has_value());
+        return route ? route->cells.size() : 0;
+    };
+
+    const size_t direct = route_length();
+    ASSERT_GT(direct, 0);
+    const size_t edges_between_free_cells = graph.num_edges();
+
+    // Wall off the middle column but the bottom cell
+    for(Cell::CoordinateType row : {0, 1})
+        slice.place_sparse_patch(SparsePatch{{PatchType::Routing, PatchActivity::None},
+                                             LayoutHelpers::basic_square_patch({row, 2}).cells}, false);
+    ASSERT_GT(route_length(), direct);
+    ASSERT_LT(graph.num_edges(), edges_between_free_cells);
+
+    slice.clear_transient_patches();
+    ASSERT_EQ(direct, route_length());
+    ASSERT_EQ(edges_between_free_cells, graph.num_edges());
+}
+#endif
+
+TEST(NegativeRouteCache, failures_last_until_their_tiles_change)
+{
+    LayoutFromSpec layout{"QrrrQrrrrrrrrrrrrr\nrrrrrrrrrrrrrrrrrr\n", DistillationOptions{}};
+    DenseSlice slice{layout, {0, 1}};
+    CustomDPRouter router;
+
+    auto place_routing_patch = [&](Cell cell){
+        slice.place_sparse_patch(SparsePatch{{PatchType::Routing, PatchActivity::None},
+                                             LayoutHelpers::basic_square_patch(cell).cells}, false);
+    };
+    place_routing_patch({0, 2});
+    place_routing_patch({1, 2});
+
+    ASSERT_FALSE(router.find_routing_ancilla(slice, 0, PauliOperator::Z, 1, PauliOperator::Z));
+    ASSERT_EQ(1, router.negative_route_cache_stats().remembered);
+    ASSERT_FALSE(router.find_routing_ancilla(slice, 0, PauliOperator::Z, 1, PauliOperator::Z));
+    ASSERT_EQ(1, router.negative_route_cache_stats().hits);
+
+    // Far away from both patches and the cells around them
+    place_routing_patch({1, 17});
+    ASSERT_FALSE(router.find_routing_ancilla(slice, 0, PauliOperator::Z, 1, PauliOperator::Z));
+    ASSERT_EQ(2, router.negative_route_cache_stats().hits);
+
+    slice.clear_transient_patches();
+    ASSERT_TRUE(router.find_routing_ancilla(slice, 0, PauliOperator::Z, 1, PauliOperator::Z));
+    ASSERT_EQ(1, router.negative_route_cache_stats().invalidations);
+}
+
+TEST(NegativeRouteCache, failures_stay_with_their_slice)
+{
+    LayoutFromSpec layout{"QrrrQrrrrrrrrrrrrr\nrrrrrrrrrrrrrrrrrr\n", DistillationOptions{}};
+    DenseSlice blocked{layout, {0, 1}};
+    DenseSlice open{layout, {0, 1}};
+    CustomDPRouter router;
+
+    auto place_routing_patch = [](DenseSlice& slice, Cell cell){
+        slice.place_sparse_patch(SparsePatch{{PatchType::Routing, PatchActivity::None},
+                                             LayoutHelpers::basic_square_patch(cell).cells}, false);
+    };
+    place_routing_patch(blocked, {0, 2});
+    place_routing_patch(blocked, {1, 2});
+    // As many changes in the same tile, but out of the way, so the versions are the same as on the blocked slice
+    place_routing_patch(open, {1, 6});
+    place_routing_patch(open, {1, 7});
+    for(size_t tile = 0; tile < blocked.region_versions()->num_tiles(); tile++)
+        ASSERT_EQ(blocked.region_versions()->version(tile), open.region_versions()->version(tile));
+
+    ASSERT_FALSE(router.find_routing_ancilla(blocked, 0, PauliOperator::Z, 1, PauliOperator::Z));
+    ASSERT_TRUE(router.find_routing_ancilla(open, 0, PauliOperator::Z, 1, PauliOperator::Z));
+    ASSERT_FALSE(router.find_routing_ancilla(blocked, 0, PauliOperator::Z, 1, PauliOperator::Z));
+    ASSERT_EQ(0, router.negative_route_cache_stats().hits);
+    ASSERT_EQ(2, router.negative_route_cache_stats().remembered);
+
+    // A copy changes independently of the original, so it doesn't share its failures either
+    DenseSlice copy = blocked;
+    copy.clear_transient_patches();
+    place_routing_patch(copy, {1, 6});
+    place_routing_patch(copy, {1, 7});
+    ASSERT_TRUE(router.find_routing_ancilla(copy, 0, PauliOperator::Z, 1, PauliOperator::Z));
+}
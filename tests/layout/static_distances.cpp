@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <lsqecc/layout/router.hpp>
+#include <lsqecc/layout/static_distances.hpp>
+#include <lsqecc/patches/dense_slice.hpp>
+#include <lsqecc/layout/ascii_layout_spec.hpp>
+
+using namespace lsqecc;
+
+
+TEST(StaticDistances, landmarks_bound_detours)
+{
+    // The only way around the wall is through the bottom row, 8 hops
+    LayoutFromSpec layout{"QrXrQ\nrrXrr\nrrrrr\n", DistillationOptions{}};
+    const StaticDistances& distances = *layout.static_distances();
+
+    ASSERT_TRUE(distances.is_blocked({0, 2}));
+    ASSERT_TRUE(distances.may_be_connected({0, 0}, {0, 4}));
+    const auto bound = distances.lower_bound({0, 0}, {0, 4});
+    ASSERT_GT(bound, 4);
+    ASSERT_LE(bound, 8);
+
+    // Consistency, which A* needs to stop at the first time it pops the target
+    layout.for_each_cell([&](const Cell& target){
+        auto heuristic = distances.heuristic_to(target);
+        layout.for_each_cell([&](const Cell& cell){
+            for(const Cell& neighbour : cell.get_neigbours_within_bounding_box_inclusive({0, 0}, layout.furthest_cell()))
+            {
+                if(!distances.is_blocked(cell) && !distances.is_blocked(neighbour))
+                {
+                    ASSERT_LE(heuristic(cell), heuristic(neighbour)+1);
+                }
+            }
+        });
+    });
+}
+
+TEST(StaticDistances, walls_rule_out_routes)
+{
+    LayoutFromSpec layout{"QrXrQ\nrrXrr\n", DistillationOptions{}};
+    ASSERT_FALSE(layout.static_distances()->may_be_connected({0, 0}, {0, 4}));
+
+    DenseSlice slice{layout, {0, 1}};
+    CustomDPRouter router;
+    ASSERT_FALSE(router.find_routing_ancilla(slice, 0, PauliOperator::Z, 1, PauliOperator::Z));
+}
+
+TEST(StaticDistances, landmark_search_finds_shortest_routes)
+{
+    LayoutFromSpec layout{"QrXrQ\nrrXrr\nrrrrr\n", DistillationOptions{}};
+    DenseSlice slice{layout, {0, 1}};
+
+    CustomDPRouter djikstra;
+    CustomDPRouter landmarks;
+    landmarks.set_graph_search_provider(GraphSearchProvider::LandmarkAStar);
+    for(auto op : {PauliOperator::X, PauliOperator::Z})
+    {
+        auto expected = djikstra.find_routing_ancilla(slice, 0, op, 1, op);
+        auto route = landmarks.find_routing_ancilla(slice, 0, op, 1, op);
+        ASSERT_EQ(expected.has_value(), route.has_value());
+        if(route)
+        {
+            ASSERT_EQ(expected->cells.size(), route->cells.size());
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <lsqecc/ls_instructions/compact_ls_instruction.hpp>
+
+using namespace lsqecc;
+
+
+TEST(CompactLSInstruction, round_trip)
+{
+    const std::vector<LSInstruction> instructions{
+        {SinglePatchMeasurement{3, PauliOperator::X, true}},
+        {MultiPatchMeasurement{{{5, PauliOperator::Z}, {2, PauliOperator::X}}, false}},
+        {MultiPatchMeasurement{{{7, PauliOperator::Y}}, true}},
+        {PatchInit{4, PatchInit::InitializeableStates::Plus}},
+        {PatchInit{4, PatchInit::InitializeableStates::Zero, PlaceNexTo{1, PauliOperator::Z}}},
+        {.operation=MagicStateRequest{8}, .wait_at_most_for=MagicStateRequest::DEFAULT_WAIT},
+        {.operation=YStateRequest{9, 1}, .wait_at_most_for=YStateRequest::DEFAULT_WAIT},
+        {SingleQubitOp{6, SingleQubitOp::Operator::S, true}},
+        {RotateSingleCellPatch{2}},
+        // Kept as payloads
+        {DeclareLogicalQubitPatches{{0, 1, 2}}},
+        {MultiPatchMeasurement{{{0, PauliOperator::Z}, {1, PauliOperator::Z}, {2, PauliOperator::X}}, false}},
+        {BusyRegion{RoutingRegion{}, 2, {}}},
+    };
+
+    LSInstructionPayloads payloads;
+    std::vector<CompactLSInstruction> compact;
+    for(const auto& instruction: instructions)
+        compact.push_back(CompactLSInstruction::from(LSInstruction{instruction}, payloads));
+
+    for(size_t i = 0; i < instructions.size(); i++)
+        ASSERT_EQ(i < 9, CompactLSInstruction::fits_inline(instructions.at(i))) << instructions.at(i);
+    ASSERT_EQ(3, payloads.size());
+    ASSERT_EQ(CompactLSInstruction::Kind::MultiPatchMeasurement, compact.at(1).kind);
+    ASSERT_EQ(CompactLSInstruction::Kind::Payload, compact.at(10).kind);
+
+    for(size_t i = 0; i < instructions.size(); i++)
+        ASSERT_EQ(instructions.at(i), compact.at(i).to_instruction(payloads)) << instructions.at(i);
+    ASSERT_EQ(0, payloads.size());
+}
+
+
+TEST(CompactLSInstruction, payload_handles_are_reused)
+{
+    LSInstructionPayloads payloads;
+    const LSInstruction declaration{DeclareLogicalQubitPatches{{0, 1}}};
+
+    auto first = CompactLSInstruction::from(LSInstruction{declaration}, payloads);
+    auto second = CompactLSInstruction::from(LSInstruction{declaration}, payloads);
+    ASSERT_NE(first.payload, second.payload);
+
+    first.to_instruction(payloads);
+    ASSERT_THROW(first.to_instruction(payloads), std::out_of_range);
+    auto third = CompactLSInstruction::from(LSInstruction{declaration}, payloads);
+    ASSERT_EQ(first.payload, third.payload);
+}
@@ -73,3 +73,18 @@ TEST(set_intersection, non_empty)
     ASSERT_EQ(1,c.count(3));
 }
 
+
+TEST(SmallVector, spills_past_inline_capacity)
+{
+    lstk::SmallVector<int, 2> v;
+    ASSERT_TRUE(v.empty());
+    v.insert(3);
+    v.insert(1);
+    v.insert(3);
+    ASSERT_EQ(2, v.size());
+    v.insert(2);
+    v.push_back(1);
+    ASSERT_EQ((std::vector<int>{3, 1, 2, 1}), std::vector<int>(v.begin(), v.end()));
+    ASSERT_TRUE(v.contains(2));
+    ASSERT_FALSE(v.contains(4));
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <lsqecc/patches/dense_slice.hpp>
+#include <lsqecc/layout/ascii_layout_spec.hpp>
+
+#include <algorithm>
+
+using namespace lsqecc;
+
+
+TEST(PackedCell, round_trip)
+{
+    DensePatch patch{
+            Patch{PatchType::PreparedState, PatchActivity::Unitary, 7},
+            CellBoundaries{
+                    Boundary{BoundaryType::Rough, true},
+                    Boundary{BoundaryType::Smooth, false},
+                    Boundary{BoundaryType::None, true},
+                    Boundary{BoundaryType::Connected, false}}};
+
+    auto unpacked = PackedCell::from_dense_patch(patch).to_dense_patch(7);
+    ASSERT_TRUE(unpacked);
+    ASSERT_EQ(static_cast<Patch>(patch), static_cast<Patch>(*unpacked));
+    ASSERT_EQ(patch.boundaries, unpacked->boundaries);
+    ASSERT_FALSE(PackedCell{}.to_dense_patch(std::nullopt));
+}
+
+TEST(DenseSlice, mutators_keep_id_index)
+{
+    LayoutFromSpec layout{"QrQ\nrrr\n", DistillationOptions{}};
+    DenseSlice slice{layout, {0, 1}};
+
+    const Cell first = slice.get_cell_by_id(0).value();
+    const Cell second = slice.get_cell_by_id(1).value();
+    ASSERT_NE(first, second);
+    slice.verify_patch_id_index();
+
+    slice.set_patch_activity(first, PatchActivity::Measurement);
+    slice.activate_boundary_between(first, Cell{first.row+1, first.col});
+    ASSERT_TRUE(slice.get_boundary_between(first, Cell{first.row+1, first.col})->is_active);
+
+    slice.clear_transient_patches();
+    slice.verify_no_transient_state();
+    ASSERT_FALSE(slice.has_patch(0));
+    ASSERT_TRUE(slice.is_cell_free(first));
+    ASSERT_EQ(second, slice.get_cell_by_id(1));
+
+    slice.set_patch_id(second, 2);
+    ASSERT_FALSE(slice.has_patch(1));
+    ASSERT_EQ(second, slice.get_cell_by_id(2));
+    slice.verify_patch_id_index();
+}
+
+TEST(DenseSlice, cells_outside_of_the_slice_throw)
+{
+    LayoutFromSpec layout{"QrQ\nrrr\n", DistillationOptions{}};
+    DenseSlice slice{layout, {0, 1}};
+
+    // {0, 3} would index the first cell of the next row
+    for(const Cell& cell : {Cell{2, 0}, Cell{0, 3}, Cell{-1, 0}})
+    {
+        ASSERT_THROW(slice.patch_at(cell), std::out_of_range);
+        ASSERT_THROW(slice.is_cell_free(cell), std::out_of_range);
+        ASSERT_THROW(slice.clear_cell(cell), std::out_of_range);
+    }
+    ASSERT_TRUE(slice.patch_at({0, 0}));
+}
+
+TEST(DenseSlice, clear_transient_patches_only_needs_dirty_cells)
+{
+    LayoutFromSpec layout{"QrQ\nrrr\n", DistillationOptions{}};
+    DenseSlice slice{layout, {0, 1}};
+    const Cell first = slice.get_cell_by_id(0).value();
+    const Cell routing{first.row+1, first.col};
+
+    slice.place_sparse_patch(SparsePatch{{PatchType::Routing, PatchActivity::None},
+                                         LayoutHelpers::basic_square_patch(routing).cells}, false);
+    slice.set_patch_activity(slice.get_cell_by_id(1).value(), PatchActivity::Unitary);
+    slice.activate_boundary_between(first, routing);
+
+    slice.clear_transient_patches();
+    slice.verify_no_transient_state();
+    ASSERT_TRUE(slice.is_cell_free(routing));
+    ASSERT_FALSE(slice.patch_at(first)->is_active());
+    ASSERT_EQ(PatchActivity::None, slice.get_patch_by_id(1)->activity);
+}
+
+TEST(DenseSlice, changed_cells_follow_mutators)
+{
+    LayoutFromSpec layout{"QrQ\nrrr\n", DistillationOptions{}};
+    DenseSlice slice{layout, {0, 1}};
+    slice.clear_changed_cells();
+    ASSERT_TRUE(slice.changed_cells().empty());
+
+    const Cell first = slice.get_cell_by_id(0).value();
+    const Cell routing{first.row+1, first.col};
+    auto index_of = [&](const Cell& cell){return static_cast<size_t>(cell.row)*3 + static_cast<size_t>(cell.col);};
+
+    slice.place_sparse_patch(SparsePatch{{PatchType::Routing, PatchActivity::None},
+                                         LayoutHelpers::basic_square_patch(routing).cells}, false);
+    slice.activate_boundary_between(first, routing);
+    slice.set_patch_activity(first, PatchActivity::Unitary);
+    std::vector<size_t> changed = slice.changed_cells();
+    std::sort(changed.begin(), changed.end());
+    ASSERT_EQ((std::vector<size_t>{index_of(first), index_of(routing)}), changed);
+
+    // Ending the time step changes them back
+    slice.clear_changed_cells();
+    slice.clear_transient_patches();
+    changed = slice.changed_cells();
+    std::sort(changed.begin(), changed.end());
+    ASSERT_EQ((std::vector<size_t>{index_of(first), index_of(routing)}), changed);
+}
+
+TEST(DenseSlice, free_cell_bitboard_tracks_occupancy)
+{
+    LayoutFromSpec layout{"QrQ\nrrr\n", DistillationOptions{}};
+    DenseSlice slice{layout, {0, 1}};
+    const Cell routing{1, 1};
+
+    auto check = [&](){
+        for(Cell::CoordinateType row = 0; row <= layout.furthest_cell().row; row++)
+            for(Cell::CoordinateType col = 0; col <= layout.furthest_cell().col; col++)
+                ASSERT_EQ(slice.is_cell_free({row, col}), slice.free_cell_bitboard()->test({row, col}));
+    };
+
+    check();
+    slice.place_sparse_patch(SparsePatch{{PatchType::Routing, PatchActivity::None},
+                                         LayoutHelpers::basic_square_patch(routing).cells}, false);
+    ASSERT_FALSE(slice.free_cell_bitboard()->test(routing));
+    check();
+    slice.clear_transient_patches();
+    ASSERT_TRUE(slice.free_cell_bitboard()->test(routing));
+    check();
+}
+
+TEST(DenseSlice, region_versions_follow_routing_state)
+{
+    LayoutFromSpec layout{"QrQ\nrrr\n", DistillationOptions{}};
+    DenseSlice slice{layout, {0, 1}};
+    const RegionVersions& versions = *slice.region_versions();
+    const Cell routing{1, 1};
+    const size_t tile = versions.tile_of(routing);
+
+    const auto initial = versions.version(tile);
+    slice.set_patch_activity(slice.get_cell_by_id(0).value(), PatchActivity::Unitary);
+    ASSERT_EQ(initial, versions.version(tile));
+
+    slice.place_sparse_patch(SparsePatch{{PatchType::Routing, PatchActivity::None},
+                                         LayoutHelpers::basic_square_patch(routing).cells}, false);
+    const auto occupied = versions.version(tile);
+    ASSERT_NE(initial, occupied);
+
+    slice.clear_transient_patches();
+    ASSERT_NE(occupied, versions.version(tile));
+}
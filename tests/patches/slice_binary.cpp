@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include <lsqecc/patches/slice_binary.hpp>
+#include <lsqecc/patches/slice_json_writer.hpp>
+#include <lsqecc/patches/dense_patch_computation.hpp>
+#include <lsqecc/layout/dynamic_layouts/compact_layout.hpp>
+#include <lsqecc/layout/router.hpp>
+#include <lsqecc/ls_instructions/ls_instruction_stream.hpp>
+#include <lsqecc/ls_instructions/teleported_s_gate_injection_stream.hpp>
+#include <lsqecc/ls_instructions/boundary_rotation_injection_stream.hpp>
+
+#include <sstream>
+
+using namespace lsqecc;
+
+
+namespace {
+
+const char* const lli_input =
+        "DeclareLogicalQubitPatches 0,1,2,3\n"
+        "MultiBodyMeasure 0:Z,1:X\n"
+        "LogicalPauli 1 X\n"
+        "HGate 2\n"
+        "RequestMagicState 100\n"
+        "MultiBodyMeasure 100:Z,3:Z\n"
+        "MeasureSinglePatch 100 X\n"
+        "MeasureSinglePatch 0 Z\n";
+
+template<typename F>
+void for_each_slice(F f)
+{
+    std::stringstream input{lli_input};
+    IdGenerator id_generator;
+    id_generator.set_start(4);
+    std::unique_ptr<LSInstructionStream> stream = std::make_unique<LSInstructionStreamFromFile>(input);
+    auto layout = make_compact_layout(stream->core_qubits().size(), DistillationOptions{});
+    stream = std::make_unique<TeleportedSGateInjectionStream>(std::move(stream), id_generator);
+    stream = std::make_unique<BoundaryRotationInjectionStream>(std::move(stream), *layout);
+    CustomDPRouter router;
+    f(*layout, [&](const DenseSliceVisitor& visitor){
+        run_through_dense_slices(std::move(*stream), false, {}, false, *layout, router, std::nullopt,
+                                 visitor, [](const LSInstruction&){}, false);
+    });
+}
+
+}
+
+
+TEST(SliceBinary, round_trip)
+{
+    for(bool delta_encode: {false, true})
+    {
+        std::vector<DenseSliceSnapshot> snapshots;
+        std::stringstream binary;
+        for_each_slice([&](const Layout& layout, auto run){
+            SliceBinaryWriter writer{binary, layout, delta_encode};
+            run([&](const DenseSlice& slice){
+                writer.write(slice);
+                snapshots.push_back(slice.snapshot());
+            });
+            writer.finish();
+        });
+        ASSERT_GT(snapshots.size(), 5);
+
+        SliceBinaryReader reader{binary};
+        ASSERT_EQ(reader.cols(), snapshots.front().width);
+        ASSERT_EQ(reader.rows()*reader.cols(), snapshots.front().cells.size());
+        for(const DenseSliceSnapshot& snapshot: snapshots)
+        {
+            ASSERT_TRUE(reader.read_next());
+            ASSERT_EQ(reader.cells(), snapshot.cells);
+            ASSERT_EQ(reader.time_to_next_magic_state_by_distillation_region(),
+                      snapshot.time_to_next_magic_state_by_distillation_region);
+            for(size_t i = 0; i < snapshot.cells.size(); i++)
+            {
+                if(snapshot.cells[i].is_occupied())
+                {
+                    ASSERT_EQ(reader.ids()[i], snapshot.ids[i]);
+                }
+            }
+        }
+        ASSERT_FALSE(reader.read_next());
+        ASSERT_EQ(reader.slices_read(), snapshots.size());
+    }
+}
+
+
+TEST(SliceBinary, converts_to_the_same_json)
+{
+    std::ostringstream json;
+    std::stringstream binary;
+    for_each_slice([&](const Layout& layout, auto run){
+        SliceJsonWriter json_writer{json, 0};
+        SliceBinaryWriter binary_writer{binary, layout, true};
+        run([&](const DenseSlice& slice){
+            json_writer.write(slice);
+            binary_writer.write(slice);
+        });
+        json_writer.finish();
+        binary_writer.finish();
+    });
+
+    std::ostringstream converted;
+    binary_slices_to_json(binary, converted, JsonStyle::Indented);
+    ASSERT_EQ(json.str(), converted.str());
+}
+
+
+TEST(SliceBinary, seeks_from_keyframes)
+{
+    std::vector<DenseSliceSnapshot> snapshots;
+    std::stringstream binary;
+    for_each_slice([&](const Layout& layout, auto run){
+        SliceBinaryWriter writer{binary, layout, true, 3};
+        run([&](const DenseSlice& slice){
+            writer.write(slice);
+            snapshots.push_back(slice.snapshot());
+        });
+        writer.finish();
+    });
+
+    SliceBinaryReader reader{binary};
+    ASSERT_EQ(reader.num_slices(), snapshots.size());
+    for(size_t slice: {size_t{4}, size_t{0}, snapshots.size()-1, size_t{3}})
+    {
+        reader.seek(slice);
+        ASSERT_EQ(reader.slices_read(), slice+1);
+        ASSERT_EQ(reader.cells(), snapshots[slice].cells);
+    }
+
+    // Reading goes on from the slice sought
+    reader.seek(1);
+    for(size_t slice = 2; slice < snapshots.size(); slice++)
+    {
+        ASSERT_TRUE(reader.read_next());
+        ASSERT_EQ(reader.cells(), snapshots[slice].cells);
+    }
+    ASSERT_FALSE(reader.read_next());
+    ASSERT_THROW(reader.seek(snapshots.size()), std::out_of_range);
+}
+
+
+TEST(SliceBinary, rejects_malformed_input)
+{
+    std::stringstream not_slices{"[\n]\n"};
+    ASSERT_THROW(SliceBinaryReader{not_slices}, std::runtime_error);
+
+    std::stringstream binary;
+    for_each_slice([&](const Layout& layout, auto run){
+        SliceBinaryWriter writer{binary, layout, false};
+        run([&](const DenseSlice& slice){writer.write(slice);});
+        writer.finish();
+    });
+
+    // Cut off halfway through the slices
+    std::string truncated = binary.str();
+    truncated.resize(truncated.size()/2);
+    std::stringstream truncated_stream{truncated};
+    SliceBinaryReader reader{truncated_stream};
+    ASSERT_THROW(while(reader.read_next()){}, std::runtime_error);
+}
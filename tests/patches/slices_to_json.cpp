@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include <lsqecc/patches/slices_to_json.hpp>
+#include <lsqecc/patches/dense_patch_computation.hpp>
+#include <lsqecc/layout/dynamic_layouts/compact_layout.hpp>
+#include <lsqecc/layout/router.hpp>
+#include <lsqecc/ls_instructions/ls_instruction_stream.hpp>
+#include <lsqecc/ls_instructions/teleported_s_gate_injection_stream.hpp>
+#include <lsqecc/ls_instructions/boundary_rotation_injection_stream.hpp>
+
+#include <sstream>
+
+using namespace lsqecc;
+
+
+TEST(SliceJsonFormatter, same_text_as_nlohmann_dump)
+{
+    std::stringstream input{
+        "DeclareLogicalQubitPatches 0,1,2,3\n"
+        "MultiBodyMeasure 0:Z,1:X\n"
+        "LogicalPauli 1 X\n"
+        "HGate 2\n"
+        "RequestMagicState 100\n"
+        "MultiBodyMeasure 100:Z,3:Z\n"
+        "MeasureSinglePatch 100 X\n"
+        "MeasureSinglePatch 0 Z\n"};
+
+    IdGenerator id_generator;
+    id_generator.set_start(4);
+    std::unique_ptr<LSInstructionStream> stream = std::make_unique<LSInstructionStreamFromFile>(input);
+    auto layout = make_compact_layout(stream->core_qubits().size(), DistillationOptions{});
+    stream = std::make_unique<TeleportedSGateInjectionStream>(std::move(stream), id_generator);
+    stream = std::make_unique<BoundaryRotationInjectionStream>(std::move(stream), *layout);
+    CustomDPRouter router;
+
+    SliceJsonFormatter indented;
+    SliceJsonFormatter compact{JsonStyle::Compact};
+    size_t slices = 0;
+    run_through_dense_slices(std::move(*stream), false, {}, false, *layout, router, std::nullopt,
+        [&](const DenseSlice& slice){
+            const nlohmann::json json = slice_to_json(slice);
+            std::string text;
+            indented.append(text, slice);
+            ASSERT_EQ(json.dump(3), text);
+
+            text.clear();
+            compact.append(text, slice.snapshot());
+            ASSERT_EQ(json.dump(), text);
+            slices++;
+        },
+        [](const LSInstruction&){}, false);
+    ASSERT_GT(slices, 5);
+}
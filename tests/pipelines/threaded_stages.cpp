@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <lsqecc/pipelines/spsc_queue.hpp>
+#include <lsqecc/ls_instructions/threaded_ls_instruction_stream.hpp>
+#include <lsqecc/patches/slice_json_writer.hpp>
+#include <lsqecc/layout/ascii_layout_spec.hpp>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace lsqecc;
+
+
+TEST(SpscQueue, keeps_order_across_threads)
+{
+    SpscQueue<int> queue{3};
+    ASSERT_EQ(4, queue.capacity());
+
+    std::thread producer{[&](){
+        for(int i = 0; i < 1000; i++)
+            queue.push(int{i});
+        queue.close();
+    }};
+
+    std::vector<int> popped;
+    while(auto value = queue.pop())
+        popped.push_back(*value);
+    producer.join();
+
+    ASSERT_EQ(1000, popped.size());
+    for(int i = 0; i < 1000; i++)
+        ASSERT_EQ(i, popped[i]);
+}
+
+
+TEST(SpscQueue, cancel_releases_a_blocked_producer)
+{
+    SpscQueue<int> queue{1};
+    bool second_push_succeeded = true;
+    std::thread producer{[&](){
+        queue.push(0);
+        second_push_succeeded = queue.push(1); // The queue is full until cancelled
+    }};
+    queue.cancel();
+    producer.join();
+
+    ASSERT_FALSE(second_push_succeeded);
+    ASSERT_FALSE(queue.pop());
+}
+
+
+TEST(ThreadedLSInstructionStream, same_instructions_as_source)
+{
+    std::stringstream input{
+        "DeclareLogicalQubitPatches 0,1\n"
+        "MultiBodyMeasure 0:Z,1:X\n"
+        "LogicalPauli 1 X\n"
+        "MeasureSinglePatch 0 Z\n"};
+
+    std::stringstream expected_input{input.str()};
+    LSInstructionStreamFromFile expected{expected_input};
+
+    ThreadedLSInstructionStream stream{std::make_unique<LSInstructionStreamFromFile>(input), 2};
+    ASSERT_EQ(expected.core_qubits(), stream.core_qubits());
+    while(expected.has_next_instruction())
+    {
+        ASSERT_TRUE(stream.has_next_instruction());
+        ASSERT_EQ(expected.get_next_instruction(), stream.get_next_instruction());
+    }
+    ASSERT_FALSE(stream.has_next_instruction());
+}
+
+
+TEST(ThreadedLSInstructionStream, rethrows_source_errors_in_order)
+{
+    const std::string input =
+        "DeclareLogicalQubitPatches 0,1\n"
+        "LogicalPauli 1 X\n"
+        "LogicalPauli 0 Z\n"
+        "NotAnInstruction 0\n";
+
+    // Reads until the error, counting the instructions that came out before it
+    auto count_until_error = [](LSInstructionStream& stream){
+        size_t count = 0;
+        EXPECT_ANY_THROW(
+            while(stream.has_next_instruction())
+            {
+                stream.get_next_instruction();
+                count++;
+            }
+        );
+        return count;
+    };
+
+    std::stringstream expected_input{input};
+    LSInstructionStreamFromFile expected{expected_input};
+    std::stringstream threaded_input{input};
+    ThreadedLSInstructionStream stream{std::make_unique<LSInstructionStreamFromFile>(threaded_input)};
+    ASSERT_EQ(count_until_error(expected), count_until_error(stream));
+}
+
+
+TEST(SliceJsonWriter, same_output_with_workers)
+{
+    LayoutFromSpec layout{"QrrrQ\nrrrrr\nrrrrr\n", DistillationOptions{}};
+    DenseSlice slice{layout, {0, 1}};
+
+    auto write_slices = [&](size_t num_workers){
+        std::stringstream output;
+        SliceJsonWriter writer{output, num_workers, JsonStyle::Indented, 2};
+        DenseSlice s{slice};
+        for(size_t i = 0; i < 20; i++)
+        {
+            s.set_patch_activity(s.get_cell_by_id(i%2).value(), i%3 ? PatchActivity::None : PatchActivity::Unitary);
+            writer.write(s);
+        }
+        writer.finish();
+        return output.str();
+    };
+
+    const std::string inline_output = write_slices(0);
+    ASSERT_EQ('[', inline_output.front());
+    ASSERT_EQ(inline_output, write_slices(1));
+    ASSERT_EQ(inline_output, write_slices(3));
+}